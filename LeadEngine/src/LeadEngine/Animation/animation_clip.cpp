@@ -0,0 +1,212 @@
+#include "le_pch.h"
+
+#include "LeadEngine/Animation/animation_clip.h"
+
+#include <cmath>
+#include <emmintrin.h>
+
+namespace le
+{
+	void Pose::resize(size_t jointCount)
+	{
+		size_t padded = (jointCount + 3) & ~(size_t)3;
+		if (padded == paddedJoints && data.size() == padded * COMPONENT_COUNT)
+			return;
+
+		paddedJoints = padded;
+		setIdentity();
+	}
+
+	void Pose::setIdentity()
+	{
+		data.assign(paddedJoints * COMPONENT_COUNT, 0.0f);
+		std::fill(get(RW), get(RW) + paddedJoints, 1.0f);
+		std::fill(get(SX), get(SZ) + paddedJoints, 1.0f);
+	}
+
+	static float getComponent(const LocalTransform& t, int c)
+	{
+		if (c <= Pose::TZ)
+			return t.position[c - Pose::TX];
+		if (c <= Pose::RW)
+			return t.rotation[c - Pose::RX];
+		return t.scale[c - Pose::SX];
+	}
+
+	AnimationClip::AnimationClip(size_t jointCount, size_t frameCount, float sampleRate, const LocalTransform* frames)
+		: jointCount(jointCount), paddedJoints((jointCount + 3) & ~(size_t)3), frameCount(frameCount), sampleRate(sampleRate)
+	{
+		LE_CORE_ASSERT(frameCount > 0, "Animation clip needs at least one frame!");
+
+		/* Flip rotation keys into the hemisphere of the previous key. */
+		std::vector<LocalTransform> aligned(frames, frames + frameCount * jointCount);
+		for (size_t f = 1; f < frameCount; f++)
+		{
+			for (size_t j = 0; j < jointCount; j++)
+			{
+				const float* prev = aligned[(f - 1) * jointCount + j].rotation;
+				float* rot = aligned[f * jointCount + j].rotation;
+
+				if (prev[0] * rot[0] + prev[1] * rot[1] + prev[2] * rot[2] + prev[3] * rot[3] < 0.0f)
+					for (int i = 0; i < 4; i++)
+						rot[i] = -rot[i];
+			}
+		}
+
+		rangeMin.assign(Pose::COMPONENT_COUNT * paddedJoints, 0.0f);
+		rangeStep.assign(Pose::COMPONENT_COUNT * paddedJoints, 0.0f);
+		keys.assign(frameCount * Pose::COMPONENT_COUNT * paddedJoints, 0);
+
+		for (int c = 0; c < Pose::COMPONENT_COUNT; c++)
+		{
+			for (size_t j = 0; j < jointCount; j++)
+			{
+				float lo = getComponent(aligned[j], c);
+				float hi = lo;
+				for (size_t f = 1; f < frameCount; f++)
+				{
+					float v = getComponent(aligned[f * jointCount + j], c);
+					lo = std::min(lo, v);
+					hi = std::max(hi, v);
+				}
+
+				float step = (hi - lo) / 65535.0f;
+				rangeMin[c * paddedJoints + j] = lo;
+				rangeStep[c * paddedJoints + j] = step;
+
+				for (size_t f = 0; f < frameCount; f++)
+				{
+					float v = getComponent(aligned[f * jointCount + j], c);
+					float q = step > 0.0f ? (v - lo) / step : 0.0f;
+					keys[(f * Pose::COMPONENT_COUNT + c) * paddedJoints + j] = (uint16_t)std::min(std::max(q + 0.5f, 0.0f), 65535.0f);
+				}
+			}
+
+			/* Padding joints decode to the identity so they stay harmless through blending. */
+			float identity = (c == Pose::RW || c >= Pose::SX) ? 1.0f : 0.0f;
+			for (size_t j = jointCount; j < paddedJoints; j++)
+				rangeMin[c * paddedJoints + j] = identity;
+		}
+	}
+
+	static void normaliseRotations(Pose& out)
+	{
+		float* rx = out.get(Pose::RX);
+		float* ry = out.get(Pose::RY);
+		float* rz = out.get(Pose::RZ);
+		float* rw = out.get(Pose::RW);
+
+		for (size_t j = 0; j < out.paddedJoints; j += 4)
+		{
+			__m128 x = _mm_loadu_ps(rx + j), y = _mm_loadu_ps(ry + j), z = _mm_loadu_ps(rz + j), w = _mm_loadu_ps(rw + j);
+			__m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w))));
+			__m128 inv = _mm_div_ps(_mm_set1_ps(1.0f), length);
+
+			_mm_storeu_ps(rx + j, _mm_mul_ps(x, inv));
+			_mm_storeu_ps(ry + j, _mm_mul_ps(y, inv));
+			_mm_storeu_ps(rz + j, _mm_mul_ps(z, inv));
+			_mm_storeu_ps(rw + j, _mm_mul_ps(w, inv));
+		}
+	}
+
+	static inline __m128 loadKeys(const uint16_t* keys)
+	{
+		__m128i packed = _mm_loadl_epi64((const __m128i*)keys);
+		return _mm_cvtepi32_ps(_mm_unpacklo_epi16(packed, _mm_setzero_si128()));
+	}
+
+	void AnimationClip::sample(float time, Pose& out) const
+	{
+		out.resize(jointCount);
+
+		float frame = std::min(std::max(time * sampleRate, 0.0f), (float)(frameCount - 1));
+		size_t f0 = (size_t)frame;
+		size_t f1 = std::min(f0 + 1, frameCount - 1);
+		__m128 t = _mm_set1_ps(frame - (float)f0);
+
+		const uint16_t* keys0 = &keys[f0 * Pose::COMPONENT_COUNT * paddedJoints];
+		const uint16_t* keys1 = &keys[f1 * Pose::COMPONENT_COUNT * paddedJoints];
+
+		for (int c = 0; c < Pose::COMPONENT_COUNT; c++)
+		{
+			size_t base = c * paddedJoints;
+			float* dst = out.get((Pose::Component)c);
+
+			for (size_t j = 0; j < paddedJoints; j += 4)
+			{
+				__m128 k0 = loadKeys(keys0 + base + j);
+				__m128 k1 = loadKeys(keys1 + base + j);
+				__m128 q = _mm_add_ps(k0, _mm_mul_ps(_mm_sub_ps(k1, k0), t));
+
+				__m128 value = _mm_add_ps(_mm_loadu_ps(&rangeMin[base + j]), _mm_mul_ps(q, _mm_loadu_ps(&rangeStep[base + j])));
+				_mm_storeu_ps(dst + j, value);
+			}
+		}
+
+		/* Renormalise after the component wise lerp (nlerp). */
+		normaliseRotations(out);
+	}
+
+	bool blendPoses(const Pose* poses, const float* weights, size_t count, Pose& out)
+	{
+		if (count == 0)
+			return false;
+
+		size_t padded = poses[0].paddedJoints;
+		for (size_t p = 0; p < count; p++)
+		{
+			if (poses[p].paddedJoints != padded || poses[p].data.size() != padded * Pose::COMPONENT_COUNT)
+			{
+				LE_CORE_ERROR("Cannot blend poses of different sizes!");
+				return false;
+			}
+		}
+
+		out.paddedJoints = padded;
+		out.data.assign(padded * Pose::COMPONENT_COUNT, 0.0f);
+
+		const float* rx0 = poses[0].get(Pose::RX);
+		const float* ry0 = poses[0].get(Pose::RY);
+		const float* rz0 = poses[0].get(Pose::RZ);
+		const float* rw0 = poses[0].get(Pose::RW);
+
+		for (size_t p = 0; p < count; p++)
+		{
+			const Pose& pose = poses[p];
+			__m128 weight = _mm_set1_ps(weights[p]);
+
+			for (int c : { Pose::TX, Pose::TY, Pose::TZ, Pose::SX, Pose::SY, Pose::SZ })
+			{
+				const float* src = pose.get((Pose::Component)c);
+				float* dst = out.get((Pose::Component)c);
+
+				for (size_t j = 0; j < padded; j += 4)
+					_mm_storeu_ps(dst + j, _mm_add_ps(_mm_loadu_ps(dst + j), _mm_mul_ps(_mm_loadu_ps(src + j), weight)));
+			}
+
+			const float* rx = pose.get(Pose::RX);
+			const float* ry = pose.get(Pose::RY);
+			const float* rz = pose.get(Pose::RZ);
+			const float* rw = pose.get(Pose::RW);
+
+			for (size_t j = 0; j < padded; j += 4)
+			{
+				__m128 x = _mm_loadu_ps(rx + j), y = _mm_loadu_ps(ry + j), z = _mm_loadu_ps(rz + j), w = _mm_loadu_ps(rw + j);
+
+				/* Take the shortest path relative to the first pose by negating the weight. */
+				__m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_loadu_ps(rx0 + j)), _mm_mul_ps(y, _mm_loadu_ps(ry0 + j))),
+					_mm_add_ps(_mm_mul_ps(z, _mm_loadu_ps(rz0 + j)), _mm_mul_ps(w, _mm_loadu_ps(rw0 + j))));
+				__m128 signBit = _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+				__m128 signedWeight = _mm_xor_ps(weight, signBit);
+
+				float* dst[4] = { out.get(Pose::RX) + j, out.get(Pose::RY) + j, out.get(Pose::RZ) + j, out.get(Pose::RW) + j };
+				__m128 src[4] = { x, y, z, w };
+				for (int i = 0; i < 4; i++)
+					_mm_storeu_ps(dst[i], _mm_add_ps(_mm_loadu_ps(dst[i]), _mm_mul_ps(src[i], signedWeight)));
+			}
+		}
+
+		normaliseRotations(out);
+		return true;
+	}
+}
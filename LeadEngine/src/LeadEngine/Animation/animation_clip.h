@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+
+#include "LeadEngine/core.h"
+#include "LeadEngine/Scene/transform_hierarchy.h"
+
+namespace le
+{
+	/* Local joint transforms in structure of arrays form, one stream per component, each padded
+	   to a multiple of 4 joints. */
+	struct LE_API Pose
+	{
+		enum Component
+		{
+			TX, TY, TZ,
+			RX, RY, RZ, RW,
+			SX, SY, SZ,
+			COMPONENT_COUNT
+		};
+
+		size_t paddedJoints = 0;
+		std::vector<float> data;
+
+		/* Joints start at the identity transform, existing data is kept if the size matches. */
+		void resize(size_t jointCount);
+		void setIdentity();
+
+		inline float* get(Component c) { return data.data() + c * paddedJoints; }
+		inline const float* get(Component c) const { return data.data() + c * paddedJoints; }
+	};
+
+	/* Uniformly sampled clip with every key quantized to 16 bits against a per joint, per
+	   component range. Consecutive rotation keys are stored in the same hemisphere so
+	   sampling can nlerp without a sign check. */
+	class LE_API AnimationClip
+	{
+	private:
+		size_t jointCount = 0;
+		size_t paddedJoints = 0;
+		size_t frameCount = 0;
+		float sampleRate = 30.0f;
+
+		/* keys[(frame * COMPONENT_COUNT + component) * paddedJoints + joint] */
+		std::vector<uint16_t> keys;
+		/* [component * paddedJoints + joint] */
+		std::vector<float> rangeMin;
+		std::vector<float> rangeStep;
+	public:
+		/* frames holds frameCount * jointCount transforms, frame major. */
+		AnimationClip(size_t jointCount, size_t frameCount, float sampleRate, const LocalTransform* frames);
+
+		/* Samples at time seconds, clamped to the clip, into out (resized to fit). */
+		void sample(float time, Pose& out) const;
+
+		inline float getDuration() const { return frameCount > 1 ? (frameCount - 1) / sampleRate : 0.0f; }
+		inline size_t getJointCount() const { return jointCount; }
+		inline size_t getMemoryUsage() const { return keys.size() * sizeof(uint16_t) + (rangeMin.size() + rangeStep.size()) * sizeof(float); }
+	};
+
+	/* Weighted blend of count poses into out. Weights should sum to 1. Returns false and leaves
+	   out unchanged if there are no poses or they differ in size. */
+	LE_API bool blendPoses(const Pose* poses, const float* weights, size_t count, Pose& out);
+}
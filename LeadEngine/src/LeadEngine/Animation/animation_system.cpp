@@ -0,0 +1,172 @@
+#include "le_pch.h"
+
+#include "LeadEngine/Animation/animation_system.h"
+#include "LeadEngine/thread_pool.h"
+
+#include <cmath>
+#include <xmmintrin.h>
+
+namespace le
+{
+	/* Characters are cheap individually, so hand them to workers in groups. */
+	static const size_t MIN_CHARACTERS_PER_TASK = 8;
+
+	void skinVertices(const Mat4* skinMatrices, const SkinnedVertex* vertices, size_t count, SkinnedOutputVertex* out)
+	{
+		alignas(16) float position[4], normal[4];
+
+		for (size_t v = 0; v < count; v++)
+		{
+			const SkinnedVertex& vertex = vertices[v];
+
+			__m128 c0 = _mm_setzero_ps(), c1 = _mm_setzero_ps(), c2 = _mm_setzero_ps(), c3 = _mm_setzero_ps();
+			for (int i = 0; i < 4; i++)
+			{
+				if (vertex.weights[i] == 0.0f)
+					continue;
+
+				const float* m = skinMatrices[vertex.joints[i]].m;
+				__m128 w = _mm_set1_ps(vertex.weights[i]);
+				c0 = _mm_add_ps(c0, _mm_mul_ps(_mm_load_ps(m), w));
+				c1 = _mm_add_ps(c1, _mm_mul_ps(_mm_load_ps(m + 4), w));
+				c2 = _mm_add_ps(c2, _mm_mul_ps(_mm_load_ps(m + 8), w));
+				c3 = _mm_add_ps(c3, _mm_mul_ps(_mm_load_ps(m + 12), w));
+			}
+
+			__m128 p = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(vertex.position[0])), _mm_mul_ps(c1, _mm_set1_ps(vertex.position[1]))),
+				_mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(vertex.position[2])), c3));
+			__m128 n = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(vertex.normal[0])), _mm_mul_ps(c1, _mm_set1_ps(vertex.normal[1]))),
+				_mm_mul_ps(c2, _mm_set1_ps(vertex.normal[2])));
+
+			_mm_store_ps(position, p);
+			_mm_store_ps(normal, n);
+
+			SkinnedOutputVertex& dst = out[v];
+			dst.position[0] = position[0]; dst.position[1] = position[1]; dst.position[2] = position[2];
+			dst.normal[0] = normal[0]; dst.normal[1] = normal[1]; dst.normal[2] = normal[2];
+		}
+	}
+
+	AnimatedCharacter::AnimatedCharacter(const Skeleton& skeleton) : skeleton(&skeleton)
+	{
+		pose.resize(skeleton.getJointCount());
+		modelPose.resize(skeleton.getJointCount(), Mat4::identity());
+		skinMatrices.resize(skeleton.getJointCount(), Mat4::identity());
+	}
+
+	void AnimatedCharacter::setSkin(const SkinnedVertex* vertices, size_t count)
+	{
+		skinVerticesIn = vertices;
+		skinnedVertices.resize(vertices ? count : 0);
+	}
+
+	bool AnimatedCharacter::addLayer(const AnimationLayer& layer)
+	{
+		if (!layer.clip || layer.clip->getJointCount() != skeleton->getJointCount())
+		{
+			LE_CORE_ERROR("Animation clip has {0} joints but the skeleton has {1}!", layer.clip ? layer.clip->getJointCount() : 0, skeleton->getJointCount());
+			return false;
+		}
+
+		layers.push_back(layer);
+		return true;
+	}
+
+	void AnimatedCharacter::update(float dt)
+	{
+		layerPoses.resize(layers.size());
+		layerWeights.clear();
+
+		size_t active = 0;
+		float totalWeight = 0.0f;
+
+		for (AnimationLayer& layer : layers)
+		{
+			if (!layer.clip || layer.weight <= 0.0f || layer.clip->getJointCount() != skeleton->getJointCount())
+				continue;
+
+			float duration = layer.clip->getDuration();
+			layer.time += dt * layer.speed;
+			if (layer.loop && duration > 0.0f)
+			{
+				layer.time = std::fmod(layer.time, duration);
+				if (layer.time < 0.0f)
+					layer.time += duration;
+			}
+
+			layer.clip->sample(layer.time, layerPoses[active++]);
+			layerWeights.push_back(layer.weight);
+			totalWeight += layer.weight;
+		}
+
+		/* Nothing to sample, so hold the last pose. Before the first sample that is the bind
+		   pose, since the skinning matrices start as identity. */
+		if (active == 0)
+		{
+			if (skinVerticesIn)
+				skinVertices(skinMatrices.data(), skinVerticesIn, skinnedVertices.size(), skinnedVertices.data());
+			return;
+		}
+
+		if (active == 1)
+			std::swap(pose, layerPoses[0]);
+		else
+		{
+			for (float& weight : layerWeights)
+				weight /= totalWeight;
+
+			blendPoses(layerPoses.data(), layerWeights.data(), active, pose);
+		}
+
+		const float* tx = pose.get(Pose::TX);
+		const float* ty = pose.get(Pose::TY);
+		const float* tz = pose.get(Pose::TZ);
+		const float* rx = pose.get(Pose::RX);
+		const float* ry = pose.get(Pose::RY);
+		const float* rz = pose.get(Pose::RZ);
+		const float* rw = pose.get(Pose::RW);
+		const float* sx = pose.get(Pose::SX);
+		const float* sy = pose.get(Pose::SY);
+		const float* sz = pose.get(Pose::SZ);
+
+		for (size_t j = 0; j < skeleton->getJointCount(); j++)
+		{
+			float position[3] = { tx[j], ty[j], tz[j] };
+			float rotation[4] = { rx[j], ry[j], rz[j], rw[j] };
+			float scale[3] = { sx[j], sy[j], sz[j] };
+			Mat4 local = Mat4::fromTRS(position, rotation, scale);
+
+			int32_t parent = skeleton->parents[j];
+			if (parent == Skeleton::NO_PARENT)
+				modelPose[j] = local;
+			else
+				multiply(modelPose[parent], local, modelPose[j]);
+
+			multiply(modelPose[j], skeleton->inverseBindPose[j], skinMatrices[j]);
+		}
+
+		if (skinVerticesIn)
+			skinVertices(skinMatrices.data(), skinVerticesIn, skinnedVertices.size(), skinnedVertices.data());
+	}
+
+	CharacterHandle AnimationSystem::addCharacter(const Skeleton& skeleton)
+	{
+		return characters.emplace(skeleton);
+	}
+
+	bool AnimationSystem::removeCharacter(CharacterHandle character)
+	{
+		return characters.erase(character);
+	}
+
+	void AnimationSystem::update(float dt)
+	{
+		auto first = characters.begin();
+
+		ThreadPool::get().parallelFor(characters.size(), [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+					first[i].update(dt);
+			}, MIN_CHARACTERS_PER_TASK);
+	}
+}
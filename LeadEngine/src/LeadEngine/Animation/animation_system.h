@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+
+#include "LeadEngine/core.h"
+#include "LeadEngine/slot_map.h"
+#include "LeadEngine/Animation/skeleton.h"
+#include "LeadEngine/Animation/animation_clip.h"
+
+namespace le
+{
+	struct SkinnedVertex
+	{
+		float position[3];
+		float normal[3];
+		uint16_t joints[4];
+		float weights[4];
+	};
+
+	struct SkinnedOutputVertex
+	{
+		float position[3];
+		float normal[3];
+	};
+
+	/* Linear blend skinning. Normals are transformed by the blended matrix without inverse
+	   transpose, so they assume uniform scale. */
+	LE_API void skinVertices(const Mat4* skinMatrices, const SkinnedVertex* vertices, size_t count, SkinnedOutputVertex* out);
+
+	struct AnimationLayer
+	{
+		const AnimationClip* clip = nullptr;
+		float time = 0.0f;
+		float speed = 1.0f;
+		float weight = 1.0f;
+		bool loop = true;
+	};
+
+	class LE_API AnimatedCharacter
+	{
+	private:
+		const Skeleton* skeleton;
+		std::vector<AnimationLayer> layers;
+
+		std::vector<Pose> layerPoses;
+		std::vector<float> layerWeights;
+		Pose pose;
+		std::vector<Mat4> modelPose;
+		std::vector<Mat4> skinMatrices;
+
+		const SkinnedVertex* skinVerticesIn = nullptr;
+		std::vector<SkinnedOutputVertex> skinnedVertices;
+	public:
+		AnimatedCharacter(const Skeleton& skeleton);
+
+		/* Advances, samples and blends every layer, then builds model space and skinning matrices.
+		   With no weighted layer the last pose is held, or the bind pose before the first sample. */
+		void update(float dt);
+
+		/* Returns false and adds nothing if the clip is missing or animates a different number
+		   of joints than the skeleton has. */
+		bool addLayer(const AnimationLayer& layer);
+
+		/* For adjusting time, speed and weight. Layers whose clip no longer matches the skeleton are skipped. */
+		inline std::vector<AnimationLayer>& getLayers() { return layers; }
+
+		/* Enables CPU skinning of vertices (not copied, must outlive the character) on update. */
+		void setSkin(const SkinnedVertex* vertices, size_t count);
+
+		inline const Pose& getPose() const { return pose; }
+		inline const std::vector<Mat4>& getModelPose() const { return modelPose; }
+		inline const std::vector<Mat4>& getSkinMatrices() const { return skinMatrices; }
+		inline const std::vector<SkinnedOutputVertex>& getSkinnedVertices() const { return skinnedVertices; }
+	};
+
+	using CharacterHandle = Handle<AnimatedCharacter>;
+
+	/* Owns characters densely and animates them in parallel on the engine thread pool. */
+	class LE_API AnimationSystem
+	{
+	private:
+		SlotMap<AnimatedCharacter> characters;
+	public:
+		CharacterHandle addCharacter(const Skeleton& skeleton);
+		bool removeCharacter(CharacterHandle character);
+
+		/* Returns nullptr for removed characters. Invalidated by addCharacter/removeCharacter. */
+		inline AnimatedCharacter* get(CharacterHandle character) { return characters.get(character); }
+
+		void update(float dt);
+
+		inline size_t getCharacterCount() const { return characters.size(); }
+	};
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+#include "LeadEngine/core.h"
+#include "LeadEngine/Math/mat4.h"
+
+namespace le
+{
+	struct Skeleton
+	{
+		static constexpr int32_t NO_PARENT = -1;
+
+		/* Sorted so that every parent comes before its children. */
+		std::vector<int32_t> parents;
+		std::vector<Mat4> inverseBindPose;
+		std::vector<std::string> names;
+
+		inline size_t getJointCount() const { return parents.size(); }
+
+		/* Joint count rounded up to the SIMD width, the size of every per-joint pose stream. */
+		inline size_t getPaddedJointCount() const { return (parents.size() + 3) & ~(size_t)3; }
+	};
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <xmmintrin.h>
+
+namespace le
+{
+	/* Column major 4x4 matrix, laid out as OpenGL expects. */
+	struct alignas(16) Mat4
+	{
+		float m[16];
+
+		static inline Mat4 identity()
+		{
+			return { { 1.0f, 0.0f, 0.0f, 0.0f,
+					   0.0f, 1.0f, 0.0f, 0.0f,
+					   0.0f, 0.0f, 1.0f, 0.0f,
+					   0.0f, 0.0f, 0.0f, 1.0f } };
+		}
+
+		/* Translation * rotation (unit quaternion x, y, z, w) * scale. */
+		static inline Mat4 fromTRS(const float position[3], const float rotation[4], const float scale[3])
+		{
+			float x = rotation[0], y = rotation[1], z = rotation[2], w = rotation[3];
+			float xx = x * x, yy = y * y, zz = z * z;
+			float xy = x * y, xz = x * z, yz = y * z;
+			float wx = w * x, wy = w * y, wz = w * z;
+
+			return { { (1.0f - 2.0f * (yy + zz)) * scale[0], 2.0f * (xy + wz) * scale[0], 2.0f * (xz - wy) * scale[0], 0.0f,
+					   2.0f * (xy - wz) * scale[1], (1.0f - 2.0f * (xx + zz)) * scale[1], 2.0f * (yz + wx) * scale[1], 0.0f,
+					   2.0f * (xz + wy) * scale[2], 2.0f * (yz - wx) * scale[2], (1.0f - 2.0f * (xx + yy)) * scale[2], 0.0f,
+					   position[0], position[1], position[2], 1.0f } };
+		}
+	};
+
+	/* out = a * b. out may alias a or b. */
+	inline void multiply(const Mat4& a, const Mat4& b, Mat4& out)
+	{
+		__m128 a0 = _mm_load_ps(a.m);
+		__m128 a1 = _mm_load_ps(a.m + 4);
+		__m128 a2 = _mm_load_ps(a.m + 8);
+		__m128 a3 = _mm_load_ps(a.m + 12);
+
+		__m128 columns[4];
+		for (int c = 0; c < 4; c++)
+		{
+			const float* bc = b.m + c * 4;
+			columns[c] = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(a0, _mm_set1_ps(bc[0])), _mm_mul_ps(a1, _mm_set1_ps(bc[1]))),
+				_mm_add_ps(_mm_mul_ps(a2, _mm_set1_ps(bc[2])), _mm_mul_ps(a3, _mm_set1_ps(bc[3]))));
+		}
+
+		for (int c = 0; c < 4; c++)
+			_mm_store_ps(out.m + c * 4, columns[c]);
+	}
+
+	inline Mat4 operator *(const Mat4& a, const Mat4& b)
+	{
+		Mat4 out;
+		multiply(a, b, out);
+		return out;
+	}
+}
@@ -0,0 +1,78 @@
+#include "le_pch.h"
+
+#include "LeadEngine/Net/bit_stream.h"
+
+namespace le
+{
+	void BitWriter::writeBits(uint32_t value, int bits)
+	{
+		LE_CORE_ASSERT(bits >= 0 && bits <= 32, "Bit count out of range!");
+
+		if (bits < 32)
+			value &= (1u << bits) - 1;
+
+		scratch |= (uint64_t)value << scratchBits;
+		scratchBits += bits;
+
+		while (scratchBits >= 8)
+		{
+			buffer.push_back((uint8_t)scratch);
+			scratch >>= 8;
+			scratchBits -= 8;
+		}
+	}
+
+	void BitWriter::writeVarUint(uint32_t value)
+	{
+		do
+		{
+			uint32_t group = value & 0xF;
+			value >>= 4;
+			writeBits(group | (value ? 0x10 : 0), 5);
+		} while (value);
+	}
+
+	void BitWriter::flush()
+	{
+		if (scratchBits > 0)
+			buffer.push_back((uint8_t)scratch);
+
+		scratch = 0;
+		scratchBits = 0;
+	}
+
+	uint32_t BitReader::readBits(int bits)
+	{
+		while (scratchBits < bits)
+		{
+			if (bytePos == size)
+			{
+				overflow = true;
+				return 0;
+			}
+			scratch |= (uint64_t)data[bytePos++] << scratchBits;
+			scratchBits += 8;
+		}
+
+		uint32_t value = (uint32_t)(bits == 32 ? scratch : scratch & ((1ull << bits) - 1));
+		scratch >>= bits;
+		scratchBits -= bits;
+		return value;
+	}
+
+	uint32_t BitReader::readVarUint()
+	{
+		uint32_t value = 0;
+		for (int shift = 0; shift < 32; shift += 4)
+		{
+			uint32_t group = readBits(5);
+			value |= (group & 0xF) << shift;
+
+			if (!(group & 0x10))
+				return value;
+		}
+
+		overflow = true;
+		return 0;
+	}
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+
+#include "LeadEngine/core.h"
+
+namespace le
+{
+	/* Packs values LSB first into a byte buffer with no alignment between values. */
+	class LE_API BitWriter
+	{
+	private:
+		std::vector<uint8_t>& buffer;
+		uint64_t scratch = 0;
+		int scratchBits = 0;
+	public:
+		/* Appends to buffer. */
+		BitWriter(std::vector<uint8_t>& buffer) : buffer(buffer) {}
+
+		void writeBits(uint32_t value, int bits);
+
+		/* Unsigned integer in 4 bit groups, each followed by a continue bit. Small values cost 5 bits. */
+		void writeVarUint(uint32_t value);
+
+		/* Flushes any partial byte. Call once when done. */
+		void flush();
+	};
+
+	class LE_API BitReader
+	{
+	private:
+		const uint8_t* data;
+		size_t size;
+		size_t bytePos = 0;
+		uint64_t scratch = 0;
+		int scratchBits = 0;
+		bool overflow = false;
+	public:
+		BitReader(const uint8_t* data, size_t size) : data(data), size(size) {}
+
+		/* Reads past the end return 0 and set the overflow flag. */
+		uint32_t readBits(int bits);
+		uint32_t readVarUint();
+
+		inline bool hasOverflowed() const { return overflow; }
+	};
+}
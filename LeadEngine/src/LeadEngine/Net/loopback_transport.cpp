@@ -0,0 +1,34 @@
+#include "le_pch.h"
+
+#include "LeadEngine/Net/loopback_transport.h"
+
+namespace le
+{
+	void LoopbackTransport::send(Side from, const std::vector<uint8_t>& packet)
+	{
+		bytesSent[from] += packet.size();
+		packetsSent[from]++;
+
+		if (dropRate > 0.0f)
+		{
+			rngState ^= rngState << 13;
+			rngState ^= rngState >> 17;
+			rngState ^= rngState << 5;
+
+			if ((rngState >> 8) * (1.0f / 16777216.0f) < dropRate)
+				return;
+		}
+
+		inbox[from == AUTHORITY ? CLIENT : AUTHORITY].push_back(packet);
+	}
+
+	bool LoopbackTransport::receive(Side to, std::vector<uint8_t>& packet)
+	{
+		if (inbox[to].empty())
+			return false;
+
+		packet = std::move(inbox[to].front());
+		inbox[to].pop_front();
+		return true;
+	}
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+
+#include "LeadEngine/core.h"
+
+namespace le
+{
+	/* In-process packet pipe between an authority and a client, for tests and benchmarks.
+	   Can drop packets to exercise baseline recovery. */
+	class LE_API LoopbackTransport
+	{
+	public:
+		enum Side { AUTHORITY = 0, CLIENT = 1 };
+	private:
+		std::deque<std::vector<uint8_t>> inbox[2];
+		size_t bytesSent[2] = { 0, 0 };
+		size_t packetsSent[2] = { 0, 0 };
+		float dropRate = 0.0f;
+		uint32_t rngState = 1;
+	public:
+		/* Queues packet for the other side. */
+		void send(Side from, const std::vector<uint8_t>& packet);
+
+		/* Pops the oldest packet sent to this side, returns false if there are none. */
+		bool receive(Side to, std::vector<uint8_t>& packet);
+
+		/* Fraction (0 - 1) of packets silently dropped, chosen by a seeded generator. */
+		inline void setDropRate(float rate, uint32_t seed = 1) { dropRate = rate; rngState = seed ? seed : 1; }
+
+		inline size_t getBytesSent(Side from) const { return bytesSent[from]; }
+		inline size_t getPacketsSent(Side from) const { return packetsSent[from]; }
+	};
+}
@@ -0,0 +1,80 @@
+#include "le_pch.h"
+
+#include "LeadEngine/Net/replication.h"
+#include "LeadEngine/Net/bit_stream.h"
+
+namespace le
+{
+	SnapshotSender::SnapshotSender(StateRegistry& registry, size_t historySize)
+		: registry(registry), history(historySize)
+	{
+	}
+
+	void SnapshotSender::writeTick(uint32_t tick, std::vector<uint8_t>& out)
+	{
+		Snapshot& snapshot = history.push(tick);
+		registry.capture(tick, snapshot);
+
+		/* Falls back to a full snapshot if the acked baseline has aged out of history. */
+		SnapshotDelta::encode(history.find(ackedTick), snapshot, out);
+	}
+
+	void SnapshotSender::readAck(const std::vector<uint8_t>& packet)
+	{
+		BitReader reader(packet.data(), packet.size());
+		uint32_t tick = reader.readBits(32);
+
+		if (reader.hasOverflowed())
+			return;
+
+		/* Acks can arrive out of order, only ever move the baseline forwards. */
+		if (ackedTick == NO_TICK || tick > ackedTick)
+			ackedTick = tick;
+	}
+
+	bool SnapshotSender::rollback(uint32_t tick) const
+	{
+		const Snapshot* snapshot = history.find(tick);
+		if (!snapshot)
+			return false;
+
+		registry.restore(*snapshot);
+		return true;
+	}
+
+	SnapshotReceiver::SnapshotReceiver(StateRegistry& registry, size_t historySize)
+		: registry(registry), history(historySize)
+	{
+	}
+
+	bool SnapshotReceiver::readTick(const std::vector<uint8_t>& packet, std::vector<uint8_t>& ack)
+	{
+		Snapshot snapshot;
+		if (!SnapshotDelta::decode(packet.data(), packet.size(), registry.getSnapshotBytes() / 4, history, snapshot))
+			return false;
+
+		if (latestTick != NO_TICK && snapshot.tick <= latestTick)
+			return false;
+
+		latestTick = snapshot.tick;
+		registry.restore(snapshot);
+
+		Snapshot& stored = history.push(snapshot.tick);
+		stored.words = std::move(snapshot.words);
+
+		BitWriter writer(ack);
+		writer.writeBits(latestTick, 32);
+		writer.flush();
+		return true;
+	}
+
+	bool SnapshotReceiver::rollback(uint32_t tick) const
+	{
+		const Snapshot* snapshot = history.find(tick);
+		if (!snapshot)
+			return false;
+
+		registry.restore(*snapshot);
+		return true;
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "LeadEngine/core.h"
+#include "LeadEngine/Net/snapshot.h"
+
+namespace le
+{
+	/* Authority side. Captures state every tick and sends it delta compressed against the
+	   newest snapshot the client has acknowledged. The same history serves rollback. */
+	class LE_API SnapshotSender
+	{
+	private:
+		StateRegistry& registry;
+		SnapshotHistory history;
+		uint32_t ackedTick = NO_TICK;
+	public:
+		SnapshotSender(StateRegistry& registry, size_t historySize = 64);
+
+		/* Captures the registered state as tick and appends its packet to out. */
+		void writeTick(uint32_t tick, std::vector<uint8_t>& out);
+
+		/* Handles an ack packet from the client. */
+		void readAck(const std::vector<uint8_t>& packet);
+
+		/* Restores the state captured at tick. Returns false if it is no longer in history. */
+		bool rollback(uint32_t tick) const;
+
+		inline uint32_t getAckedTick() const { return ackedTick; }
+	};
+
+	/* Client side. Applies snapshot packets to the registered state and acknowledges them. */
+	class LE_API SnapshotReceiver
+	{
+	private:
+		StateRegistry& registry;
+		SnapshotHistory history;
+		uint32_t latestTick = NO_TICK;
+	public:
+		SnapshotReceiver(StateRegistry& registry, size_t historySize = 64);
+
+		/* Decodes and restores the packet, then appends the ack to send back to ack.
+		   Out of date or undecodable packets are ignored and return false. */
+		bool readTick(const std::vector<uint8_t>& packet, std::vector<uint8_t>& ack);
+
+		bool rollback(uint32_t tick) const;
+
+		inline uint32_t getLatestTick() const { return latestTick; }
+	};
+}
@@ -0,0 +1,171 @@
+#include "le_pch.h"
+
+#include "LeadEngine/Net/snapshot.h"
+#include "LeadEngine/Net/bit_stream.h"
+
+#include <cstring>
+
+namespace le
+{
+	void StateRegistry::registerBlock(const std::string& name, void* data, size_t size)
+	{
+		blocks.push_back({ name, data, size, snapshotBytes });
+		snapshotBytes += size;
+	}
+
+	void StateRegistry::capture(uint32_t tick, Snapshot& out) const
+	{
+		out.tick = tick;
+
+		/* Zero the padding word so identical state always encodes identically. */
+		out.words.resize(getSnapshotBytes() / 4);
+		if (!out.words.empty())
+			out.words.back() = 0;
+
+		uint8_t* dst = (uint8_t*)out.words.data();
+		for (const Block& block : blocks)
+			std::memcpy(dst + block.offset, block.data, block.size);
+	}
+
+	void StateRegistry::restore(const Snapshot& snapshot) const
+	{
+		if (snapshot.words.size() * 4 != getSnapshotBytes())
+		{
+			LE_CORE_ERROR("Snapshot for tick {0} does not match the registered state!", snapshot.tick);
+			return;
+		}
+
+		const uint8_t* src = (const uint8_t*)snapshot.words.data();
+		for (const Block& block : blocks)
+			std::memcpy(block.data, src + block.offset, block.size);
+	}
+
+	SnapshotHistory::SnapshotHistory(size_t capacity) : snapshots(capacity)
+	{
+	}
+
+	Snapshot& SnapshotHistory::push(uint32_t tick)
+	{
+		Snapshot& slot = snapshots[tick % snapshots.size()];
+		slot.tick = tick;
+		return slot;
+	}
+
+	const Snapshot* SnapshotHistory::find(uint32_t tick) const
+	{
+		if (tick == NO_TICK)
+			return nullptr;
+
+		const Snapshot& slot = snapshots[tick % snapshots.size()];
+		return slot.tick == tick ? &slot : nullptr;
+	}
+
+	static int significantBits(uint32_t value)
+	{
+		int bits = 0;
+		while (value)
+		{
+			bits++;
+			value >>= 1;
+		}
+		return bits;
+	}
+
+	void SnapshotDelta::encode(const Snapshot* baseline, const Snapshot& current, std::vector<uint8_t>& out)
+	{
+		size_t wordCount = current.words.size();
+		if (baseline && baseline->words.size() != wordCount)
+			baseline = nullptr;
+
+		const uint32_t* base = baseline ? baseline->words.data() : nullptr;
+		const uint32_t* words = current.words.data();
+
+		uint32_t changed = 0;
+		for (size_t i = 0; i < wordCount; i++)
+			changed += (base ? base[i] : 0) != words[i];
+
+		BitWriter writer(out);
+		writer.writeBits(current.tick, 32);
+		writer.writeBits(baseline ? baseline->tick : NO_TICK, 32);
+		writer.writeVarUint((uint32_t)wordCount);
+		writer.writeVarUint(changed);
+
+		uint32_t skip = 0;
+		for (size_t i = 0; i < wordCount; i++)
+		{
+			uint32_t diff = (base ? base[i] : 0) ^ words[i];
+			if (!diff)
+			{
+				skip++;
+				continue;
+			}
+
+			int bits = significantBits(diff);
+			writer.writeVarUint(skip);
+			writer.writeBits(bits - 1, 5);
+			writer.writeBits(diff, bits);
+			skip = 0;
+		}
+
+		writer.flush();
+	}
+
+	bool SnapshotDelta::decode(const uint8_t* data, size_t size, size_t expectedWords, const SnapshotHistory& history, Snapshot& out)
+	{
+		BitReader reader(data, size);
+		uint32_t tick = reader.readBits(32);
+		uint32_t baselineTick = reader.readBits(32);
+		uint32_t wordCount = reader.readVarUint();
+		uint32_t changed = reader.readVarUint();
+
+		if (reader.hasOverflowed())
+		{
+			LE_CORE_ERROR("Truncated snapshot packet!");
+			return false;
+		}
+
+		if (wordCount != expectedWords || changed > wordCount)
+		{
+			LE_CORE_ERROR("Snapshot {0} has {1} words ({2} changed), expected {3}!", tick, wordCount, changed, expectedWords);
+			return false;
+		}
+
+		const Snapshot* baseline = nullptr;
+		if (baselineTick != NO_TICK)
+		{
+			baseline = history.find(baselineTick);
+			if (!baseline || baseline->words.size() != wordCount)
+			{
+				LE_CORE_ERROR("Snapshot {0} references missing baseline {1}!", tick, baselineTick);
+				return false;
+			}
+		}
+
+		/* out may itself live in history, so only overwrite it once the baseline has been copied. */
+		std::vector<uint32_t> words;
+		if (baseline)
+			words = baseline->words;
+		else
+			words.assign(wordCount, 0);
+
+		size_t pos = 0;
+		for (uint32_t i = 0; i < changed; i++)
+		{
+			pos += reader.readVarUint();
+			int bits = (int)reader.readBits(5) + 1;
+			uint32_t diff = reader.readBits(bits);
+
+			if (reader.hasOverflowed() || pos >= wordCount)
+			{
+				LE_CORE_ERROR("Malformed snapshot packet for tick {0}!", tick);
+				return false;
+			}
+
+			words[pos++] ^= diff;
+		}
+
+		out.tick = tick;
+		out.words = std::move(words);
+		return true;
+	}
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "LeadEngine/core.h"
+
+namespace le
+{
+	static constexpr uint32_t NO_TICK = 0xFFFFFFFF;
+
+	/* Registered state captured at one tick, stored as 32-bit words so deltas can XOR whole words. */
+	struct Snapshot
+	{
+		uint32_t tick = NO_TICK;
+		std::vector<uint32_t> words;
+	};
+
+	/* Set of memory blocks making up replicated/rollback state. Blocks must be trivially
+	   copyable and must not move while registered. */
+	class LE_API StateRegistry
+	{
+	private:
+		struct Block
+		{
+			std::string name;
+			void* data;
+			size_t size;
+			size_t offset;
+		};
+
+		std::vector<Block> blocks;
+		size_t snapshotBytes = 0;
+	public:
+		void registerBlock(const std::string& name, void* data, size_t size);
+
+		template<typename T>
+		void registerState(const std::string& name, T& state)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Snapshot state must be trivially copyable.");
+			registerBlock(name, &state, sizeof(T));
+		}
+
+		void capture(uint32_t tick, Snapshot& out) const;
+		void restore(const Snapshot& snapshot) const;
+
+		/* Size of one snapshot, padded to whole words. */
+		inline size_t getSnapshotBytes() const { return (snapshotBytes + 3) & ~(size_t)3; }
+	};
+
+	/* Ring buffer of the most recent snapshots, used for delta baselines and rollback. */
+	class LE_API SnapshotHistory
+	{
+	private:
+		std::vector<Snapshot> snapshots;
+	public:
+		SnapshotHistory(size_t capacity = 64);
+
+		/* Returns the slot for tick, overwriting the oldest snapshot. Reuses its storage. */
+		Snapshot& push(uint32_t tick);
+
+		/* Returns nullptr if tick has been overwritten or was never stored. */
+		const Snapshot* find(uint32_t tick) const;
+	};
+
+	/* Delta compression between snapshots. A packet stores only the words that differ from the
+	   baseline, each as a bit-packed skip count and the significant bits of the XOR. */
+	class LE_API SnapshotDelta
+	{
+	public:
+		/* Appends a packet to out. A null baseline encodes against all zeros (a full snapshot). */
+		static void encode(const Snapshot* baseline, const Snapshot& current, std::vector<uint8_t>& out);
+
+		/* Rebuilds the snapshot using the baseline named in the packet. Returns false if the
+		   packet is malformed, is not expectedWords long or its baseline is not in history.
+		   Nothing is allocated before the sizes are validated. */
+		static bool decode(const uint8_t* data, size_t size, size_t expectedWords, const SnapshotHistory& history, Snapshot& out);
+	};
+}
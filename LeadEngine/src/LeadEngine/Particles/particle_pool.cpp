@@ -0,0 +1,130 @@
+#include "le_pch.h"
+
+#include "LeadEngine/Particles/particle_pool.h"
+
+#include <xmmintrin.h>
+
+namespace le
+{
+	ParticlePool::ParticlePool(size_t maxParticles)
+	{
+		capacity = (maxParticles + 3) & ~(size_t)3;
+
+		size_t bytes = capacity * STREAM_COUNT * sizeof(float);
+		data = (float*)_mm_malloc(bytes, 16);
+		LE_CORE_ASSERT(data, "Could not allocate particle pool!");
+
+		/* Lanes past count are still processed by the kernels, so give them a valid life time.
+		   Vacated slots keep the life time of the particle that died there. */
+		std::fill(data, data + capacity * STREAM_COUNT, 0.0f);
+		std::fill(getStream(LIFE), getStream(LIFE) + capacity, 1.0f);
+	}
+
+	ParticlePool::~ParticlePool()
+	{
+		_mm_free(data);
+	}
+
+	size_t ParticlePool::spawn()
+	{
+		if (count == capacity)
+			return capacity;
+
+		return count++;
+	}
+
+	void ParticlePool::integrate(float dt, const float gravity[3])
+	{
+		float* pos[3] = { getStream(POS_X), getStream(POS_Y), getStream(POS_Z) };
+		float* vel[3] = { getStream(VEL_X), getStream(VEL_Y), getStream(VEL_Z) };
+		float* age = getStream(AGE);
+
+		__m128 step = _mm_set1_ps(dt);
+		size_t end = (count + 3) & ~(size_t)3;
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			__m128 dv = _mm_set1_ps(gravity[axis] * dt);
+			float* p = pos[axis];
+			float* v = vel[axis];
+
+			for (size_t i = 0; i < end; i += 4)
+			{
+				__m128 vi = _mm_load_ps(v + i);
+				_mm_store_ps(p + i, _mm_add_ps(_mm_load_ps(p + i), _mm_mul_ps(vi, step)));
+				_mm_store_ps(v + i, _mm_add_ps(vi, dv));
+			}
+		}
+
+		for (size_t i = 0; i < end; i += 4)
+			_mm_store_ps(age + i, _mm_add_ps(_mm_load_ps(age + i), step));
+	}
+
+	void ParticlePool::applyOverLife(const float colorBegin[4], const float colorEnd[4], float sizeBegin, float sizeEnd)
+	{
+		const float* age = getStream(AGE);
+		const float* life = getStream(LIFE);
+		float* size = getStream(SIZE);
+		float* col[4] = { getStream(COL_R), getStream(COL_G), getStream(COL_B), getStream(COL_A) };
+
+		__m128 begin[4], delta[4];
+		for (int c = 0; c < 4; c++)
+		{
+			begin[c] = _mm_set1_ps(colorBegin[c]);
+			delta[c] = _mm_set1_ps(colorEnd[c] - colorBegin[c]);
+		}
+		__m128 sBegin = _mm_set1_ps(sizeBegin);
+		__m128 sDelta = _mm_set1_ps(sizeEnd - sizeBegin);
+		__m128 one = _mm_set1_ps(1.0f);
+
+		size_t end = (count + 3) & ~(size_t)3;
+		for (size_t i = 0; i < end; i += 4)
+		{
+			__m128 t = _mm_min_ps(_mm_div_ps(_mm_load_ps(age + i), _mm_load_ps(life + i)), one);
+
+			for (int c = 0; c < 4; c++)
+				_mm_store_ps(col[c] + i, _mm_add_ps(begin[c], _mm_mul_ps(delta[c], t)));
+
+			_mm_store_ps(size + i, _mm_add_ps(sBegin, _mm_mul_ps(sDelta, t)));
+		}
+	}
+
+	void ParticlePool::compact()
+	{
+		const float* age = getStream(AGE);
+		const float* life = getStream(LIFE);
+
+		size_t i = 0;
+		while (i < count)
+		{
+			if (age[i] < life[i])
+			{
+				i++;
+				continue;
+			}
+
+			/* Move the last live particle into the hole. Re-test i since it now holds a different particle. */
+			size_t last = --count;
+			for (int s = 0; s < STREAM_COUNT; s++)
+			{
+				float* stream = getStream((Stream)s);
+				stream[i] = stream[last];
+			}
+		}
+	}
+
+	void ParticlePool::writeInstances(ParticleInstance* out) const
+	{
+		const float* px = getStream(POS_X);
+		const float* py = getStream(POS_Y);
+		const float* pz = getStream(POS_Z);
+		const float* size = getStream(SIZE);
+		const float* r = getStream(COL_R);
+		const float* g = getStream(COL_G);
+		const float* b = getStream(COL_B);
+		const float* a = getStream(COL_A);
+
+		for (size_t i = 0; i < count; i++)
+			out[i] = { px[i], py[i], pz[i], size[i], r[i], g[i], b[i], a[i] };
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+
+#include "LeadEngine/core.h"
+
+namespace le
+{
+	/* Per particle data handed to the renderer, one entry per live particle. */
+	struct ParticleInstance
+	{
+		float x, y, z, size;
+		float r, g, b, a;
+	};
+
+	/* Structure of arrays particle storage. Every stream is 16 byte aligned and padded to a
+	   multiple of 4 so the kernels can run 4 particles per SSE instruction with no scalar tail. */
+	class LE_API ParticlePool
+	{
+	public:
+		enum Stream
+		{
+			POS_X, POS_Y, POS_Z,
+			VEL_X, VEL_Y, VEL_Z,
+			AGE, LIFE, SIZE,
+			COL_R, COL_G, COL_B, COL_A,
+			STREAM_COUNT
+		};
+	private:
+		float* data = nullptr;
+		size_t capacity = 0;
+		size_t count = 0;
+	public:
+		ParticlePool(size_t maxParticles);
+		~ParticlePool();
+
+		ParticlePool(const ParticlePool&) = delete;
+		ParticlePool& operator =(const ParticlePool&) = delete;
+
+		/* Returns the index of the new particle, or getCapacity() if the pool is full. */
+		size_t spawn();
+
+		/* pos += vel * dt, vel += gravity * dt, age += dt. */
+		void integrate(float dt, const float gravity[3]);
+
+		/* Interpolates color and size by normalised age. */
+		void applyOverLife(const float colorBegin[4], const float colorEnd[4], float sizeBegin, float sizeEnd);
+
+		/* Swap-removes every particle whose age has reached its life time. Does not preserve order. */
+		void compact();
+
+		/* Writes getCount() packed instances to out. */
+		void writeInstances(ParticleInstance* out) const;
+
+		inline float* getStream(Stream stream) { return data + stream * capacity; }
+		inline const float* getStream(Stream stream) const { return data + stream * capacity; }
+
+		inline size_t getCount() const { return count; }
+		inline size_t getCapacity() const { return capacity; }
+	};
+}
@@ -0,0 +1,108 @@
+#include "le_pch.h"
+
+#include "LeadEngine/Particles/particle_system.h"
+#include "LeadEngine/thread_pool.h"
+
+namespace le
+{
+	ParticleEmitter::ParticleEmitter(const ParticleEmitterProps& props, uint32_t seed)
+		: props(props), pool(props.maxParticles), rngState(seed ? seed : 1)
+	{
+		instances.reserve(pool.getCapacity());
+	}
+
+	/* xorshift32 in [-1, 1]. Each emitter keeps its own state so emitters can update on any thread. */
+	float ParticleEmitter::random()
+	{
+		rngState ^= rngState << 13;
+		rngState ^= rngState >> 17;
+		rngState ^= rngState << 5;
+		return (float)(rngState >> 8) * (2.0f / 16777216.0f) - 1.0f;
+	}
+
+	void ParticleEmitter::update(float dt)
+	{
+		emitAccumulator += props.emissionRate * dt;
+
+		float* px = pool.getStream(ParticlePool::POS_X);
+		float* py = pool.getStream(ParticlePool::POS_Y);
+		float* pz = pool.getStream(ParticlePool::POS_Z);
+		float* vx = pool.getStream(ParticlePool::VEL_X);
+		float* vy = pool.getStream(ParticlePool::VEL_Y);
+		float* vz = pool.getStream(ParticlePool::VEL_Z);
+		float* age = pool.getStream(ParticlePool::AGE);
+		float* life = pool.getStream(ParticlePool::LIFE);
+
+		while (emitAccumulator >= 1.0f)
+		{
+			emitAccumulator -= 1.0f;
+
+			size_t i = pool.spawn();
+			if (i == pool.getCapacity())
+			{
+				emitAccumulator = 0.0f;
+				break;
+			}
+
+			px[i] = props.position[0];
+			py[i] = props.position[1];
+			pz[i] = props.position[2];
+			vx[i] = props.velocity[0] + props.velocityVariation[0] * random();
+			vy[i] = props.velocity[1] + props.velocityVariation[1] * random();
+			vz[i] = props.velocity[2] + props.velocityVariation[2] * random();
+			age[i] = 0.0f;
+			life[i] = std::max(props.lifeTime + props.lifeVariation * random(), 0.001f);
+		}
+
+		pool.integrate(dt, props.gravity);
+		pool.compact();
+		pool.applyOverLife(props.colorBegin, props.colorEnd, props.sizeBegin, props.sizeEnd);
+
+		instances.resize(pool.getCount());
+		pool.writeInstances(instances.data());
+	}
+
+	ParticleSystem::ParticleSystem(const std::string& name) : Layer(name)
+	{
+	}
+
+	ParticleEmitter& ParticleSystem::addEmitter(const ParticleEmitterProps& props)
+	{
+		emitters.emplace_back(std::make_unique<ParticleEmitter>(props, (uint32_t)emitters.size() * 2654435761u + 1));
+		return *emitters.back();
+	}
+
+	void ParticleSystem::clear()
+	{
+		emitters.clear();
+	}
+
+	void ParticleSystem::update()
+	{
+		auto now = std::chrono::steady_clock::now();
+		float dt = started ? std::chrono::duration<float>(now - lastUpdate).count() : 0.0f;
+
+		lastUpdate = now;
+		started = true;
+
+		simulate(dt);
+	}
+
+	void ParticleSystem::simulate(float dt)
+	{
+		ThreadPool::get().parallelFor(emitters.size(), [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+					emitters[i]->update(dt);
+			});
+	}
+
+	size_t ParticleSystem::getAliveCount() const
+	{
+		size_t alive = 0;
+		for (const auto& emitter : emitters)
+			alive += emitter->getAliveCount();
+
+		return alive;
+	}
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <chrono>
+
+#include "LeadEngine/core.h"
+#include "LeadEngine/layer.h"
+#include "LeadEngine/Particles/particle_pool.h"
+
+namespace le
+{
+	struct ParticleEmitterProps
+	{
+		float position[3] = { 0.0f, 0.0f, 0.0f };
+		float velocity[3] = { 0.0f, 1.0f, 0.0f };
+		float velocityVariation[3] = { 0.5f, 0.5f, 0.5f };
+		float gravity[3] = { 0.0f, -9.8f, 0.0f };
+
+		float colorBegin[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+		float colorEnd[4] = { 1.0f, 1.0f, 1.0f, 0.0f };
+		float sizeBegin = 1.0f, sizeEnd = 0.0f;
+
+		float lifeTime = 1.0f;
+		float lifeVariation = 0.0f;
+
+		/* Particles spawned per second. */
+		float emissionRate = 100.0f;
+		size_t maxParticles = 10000;
+	};
+
+	class LE_API ParticleEmitter
+	{
+	private:
+		float random();
+
+		ParticleEmitterProps props;
+		ParticlePool pool;
+		std::vector<ParticleInstance> instances;
+		float emitAccumulator = 0.0f;
+		uint32_t rngState;
+	public:
+		ParticleEmitter(const ParticleEmitterProps& props, uint32_t seed = 1);
+
+		/* Spawns, simulates and retires particles, then refreshes the instance data. */
+		void update(float dt);
+
+		inline ParticleEmitterProps& getProps() { return props; }
+		inline const std::vector<ParticleInstance>& getInstances() const { return instances; }
+		inline size_t getAliveCount() const { return pool.getCount(); }
+	};
+
+	/* Layer that owns a set of emitters and updates them in parallel on the engine thread pool. */
+	class LE_API ParticleSystem : public Layer
+	{
+	private:
+		std::vector<std::unique_ptr<ParticleEmitter>> emitters;
+		std::chrono::steady_clock::time_point lastUpdate;
+		bool started = false;
+	public:
+		ParticleSystem(const std::string& name = "ParticleSystem");
+
+		ParticleSystem(const ParticleSystem&) = delete;
+		ParticleSystem& operator =(const ParticleSystem&) = delete;
+
+		ParticleEmitter& addEmitter(const ParticleEmitterProps& props);
+		void clear();
+
+		/* Advances by the wall clock time since the previous update. */
+		void update() override;
+		void simulate(float dt);
+
+		size_t getAliveCount() const;
+
+		inline const std::vector<std::unique_ptr<ParticleEmitter>>& getEmitters() const { return emitters; }
+	};
+}
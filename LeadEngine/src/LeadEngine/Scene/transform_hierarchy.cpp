@@ -0,0 +1,331 @@
+#include "le_pch.h"
+
+#include "LeadEngine/Scene/transform_hierarchy.h"
+#include "LeadEngine/thread_pool.h"
+
+namespace le
+{
+	/* Smallest slice of a level worth handing to another thread. */
+	static const size_t MIN_NODES_PER_TASK = 2048;
+	/* Above one dirty node in this many, walking every level beats walking each dirty subtree. */
+	static const size_t FULL_PASS_RATIO = 8;
+
+	TransformHierarchy::TransformHierarchy()
+	{
+	}
+
+	TransformHierarchy::NodeId TransformHierarchy::createNode(NodeId parent, const LocalTransform& local)
+	{
+		if (parent != INVALID_NODE && !isValid(parent))
+		{
+			LE_CORE_ERROR("Cannot create a node under the stale node {0}!", parent.index);
+			return INVALID_NODE;
+		}
+
+		uint32_t index;
+		if (!freeNodes.empty())
+		{
+			index = freeNodes.back();
+			freeNodes.pop_back();
+		}
+		else
+		{
+			index = (uint32_t)nodeToSlot.size();
+			nodeToSlot.push_back(NO_SLOT);
+			generations.push_back(0);
+		}
+
+		/* Odd again, so handles from before the index was freed stay stale. */
+		generations[index]++;
+
+		/* Appended out of order; rebuild() moves it into place on the next update. */
+		uint32_t slot = (uint32_t)slotToNode.size();
+		nodeToSlot[index] = slot;
+		slotToNode.push_back(index);
+		locals.push_back(local);
+		worlds.push_back(Mat4::identity());
+		parents.push_back(parent == INVALID_NODE ? NO_PARENT : nodeToSlot[parent.index]);
+		childBegin.push_back(0);
+		childEnd.push_back(0);
+		dirty.push_back(0);
+		removed.push_back(0);
+		markDirty(slot);
+
+		orderDirty = true;
+		return { index, generations[index] };
+	}
+
+	bool TransformHierarchy::destroyNode(NodeId node)
+	{
+		if (!isValid(node))
+			return false;
+
+		removed[nodeToSlot[node.index]] = 1;
+		orderDirty = true;
+		return true;
+	}
+
+	bool TransformHierarchy::setParent(NodeId node, NodeId parent)
+	{
+		if (!isValid(node) || (parent != INVALID_NODE && !isValid(parent)))
+		{
+			LE_CORE_ERROR("Cannot parent stale nodes!");
+			return false;
+		}
+
+		uint32_t slot = nodeToSlot[node.index];
+		uint32_t parentSlot = parent == INVALID_NODE ? NO_PARENT : nodeToSlot[parent.index];
+
+		/* A cycle would detach the nodes from every root in rebuild(), so this check cannot be an assert. */
+		for (uint32_t ancestor = parentSlot; ancestor != NO_PARENT; ancestor = parents[ancestor])
+		{
+			if (ancestor == slot)
+			{
+				LE_CORE_ERROR("Cannot parent node {0} to its own descendant {1}!", node.index, parent.index);
+				return false;
+			}
+		}
+
+		parents[slot] = parentSlot;
+		markDirty(slot);
+		orderDirty = true;
+		return true;
+	}
+
+	bool TransformHierarchy::setLocal(NodeId node, const LocalTransform& local)
+	{
+		if (!isValid(node))
+			return false;
+
+		uint32_t slot = nodeToSlot[node.index];
+		locals[slot] = local;
+		markDirty(slot);
+		return true;
+	}
+
+	TransformHierarchy::NodeId TransformHierarchy::getParent(NodeId node) const
+	{
+		LE_CORE_ASSERT(isValid(node), "Invalid node!");
+
+		uint32_t parentSlot = parents[nodeToSlot[node.index]];
+		if (parentSlot == NO_PARENT)
+			return INVALID_NODE;
+
+		uint32_t index = slotToNode[parentSlot];
+		return { index, generations[index] };
+	}
+
+	bool TransformHierarchy::isValid(NodeId node) const
+	{
+		return (node.generation & 1) && node.index < generations.size() && generations[node.index] == node.generation && !removed[nodeToSlot[node.index]];
+	}
+
+	void TransformHierarchy::markDirty(uint32_t slot)
+	{
+		if (dirty[slot])
+			return;
+
+		dirty[slot] = 1;
+		dirtySlots.push_back(slot);
+	}
+
+	void TransformHierarchy::rebuild()
+	{
+		size_t count = slotToNode.size();
+
+		/* Children of every slot, in slot order. Parents may come after children here because
+		   of createNode/setParent since the last rebuild. */
+		std::vector<uint32_t> childOffsets(count + 1, 0);
+		for (size_t i = 0; i < count; i++)
+			if (parents[i] != NO_PARENT)
+				childOffsets[parents[i] + 1]++;
+		for (size_t i = 0; i < count; i++)
+			childOffsets[i + 1] += childOffsets[i];
+
+		std::vector<uint32_t> children(childOffsets.back());
+		std::vector<uint32_t> next(childOffsets.begin(), childOffsets.end() - 1);
+		for (size_t i = 0; i < count; i++)
+			if (parents[i] != NO_PARENT)
+				children[next[parents[i]]++] = (uint32_t)i;
+
+		/* Breadth first from the live roots. Removed nodes are not enqueued, so their
+		   descendants are never reached and die with them. */
+		std::vector<uint32_t> order;
+		order.reserve(count);
+		for (size_t i = 0; i < count; i++)
+			if (parents[i] == NO_PARENT && !removed[i])
+				order.push_back((uint32_t)i);
+
+		std::vector<uint32_t> newChildBegin, newChildEnd;
+		newChildBegin.reserve(count);
+		newChildEnd.reserve(count);
+
+		levelStarts.clear();
+		levelStarts.push_back(0);
+		size_t levelEnd = order.size();
+		for (size_t i = 0; i < order.size(); i++)
+		{
+			if (i == levelEnd)
+			{
+				levelStarts.push_back(i);
+				levelEnd = order.size();
+			}
+
+			uint32_t old = order[i];
+			newChildBegin.push_back((uint32_t)order.size());
+			for (uint32_t c = childOffsets[old]; c < childOffsets[old + 1]; c++)
+				if (!removed[children[c]])
+					order.push_back(children[c]);
+			newChildEnd.push_back((uint32_t)order.size());
+		}
+		levelStarts.push_back(order.size());
+		if (order.empty())
+			levelStarts.clear();
+
+		size_t aliveCount = order.size();
+		std::vector<uint32_t> oldToNew(count, NO_SLOT);
+		for (size_t i = 0; i < aliveCount; i++)
+			oldToNew[order[i]] = (uint32_t)i;
+
+		std::vector<LocalTransform> newLocals(aliveCount);
+		std::vector<Mat4> newWorlds(aliveCount);
+		std::vector<uint32_t> newParents(aliveCount);
+		std::vector<uint8_t> newDirty(aliveCount);
+		std::vector<uint32_t> newSlotToNode(aliveCount);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			uint32_t index = slotToNode[i];
+			if (oldToNew[i] == NO_SLOT)
+			{
+				/* Even, so every handle to the node is stale from now on. */
+				nodeToSlot[index] = NO_SLOT;
+				generations[index]++;
+				freeNodes.push_back(index);
+				continue;
+			}
+
+			uint32_t slot = oldToNew[i];
+			newLocals[slot] = locals[i];
+			newWorlds[slot] = worlds[i];
+			newParents[slot] = parents[i] == NO_PARENT ? NO_PARENT : oldToNew[parents[i]];
+			newDirty[slot] = dirty[i];
+			newSlotToNode[slot] = index;
+			nodeToSlot[index] = slot;
+		}
+
+		locals = std::move(newLocals);
+		worlds = std::move(newWorlds);
+		parents = std::move(newParents);
+		childBegin = std::move(newChildBegin);
+		childEnd = std::move(newChildEnd);
+		dirty = std::move(newDirty);
+		slotToNode = std::move(newSlotToNode);
+		removed.assign(aliveCount, 0);
+
+		dirtySlots.clear();
+		for (size_t i = 0; i < aliveCount; i++)
+			if (dirty[i])
+				dirtySlots.push_back((uint32_t)i);
+
+		orderDirty = false;
+	}
+
+	void TransformHierarchy::updateRange(size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			const LocalTransform& local = locals[i];
+			Mat4 localMatrix = Mat4::fromTRS(local.position, local.rotation, local.scale);
+
+			uint32_t parent = parents[i];
+			if (parent == NO_PARENT)
+				worlds[i] = localMatrix;
+			else
+				multiply(worlds[parent], localMatrix, worlds[i]);
+		}
+	}
+
+	void TransformHierarchy::updateLevels()
+	{
+		ThreadPool& pool = ThreadPool::get();
+
+		for (size_t d = 0; d + 1 < levelStarts.size(); d++)
+		{
+			size_t levelBegin = levelStarts[d];
+			pool.parallelFor(levelStarts[d + 1] - levelBegin, [&](size_t begin, size_t end)
+				{
+					for (size_t i = levelBegin + begin; i < levelBegin + end; i++)
+					{
+						/* Parents were finished in the previous level, so their flag already says whether they moved. */
+						uint32_t parent = parents[i];
+						if (parent != NO_PARENT)
+							dirty[i] |= dirty[parent];
+
+						if (dirty[i])
+							updateRange(i, i + 1);
+					}
+				}, MIN_NODES_PER_TASK);
+		}
+
+		for (uint8_t flag : dirty)
+			lastUpdatedCount += flag;
+
+		std::fill(dirty.begin(), dirty.end(), 0);
+	}
+
+	size_t TransformHierarchy::updateSubtree(uint32_t root)
+	{
+		ThreadPool& pool = ThreadPool::get();
+		size_t updated = 0;
+
+		/* The children of a contiguous range of parents are a contiguous range of the next level. */
+		for (size_t begin = root, end = root + 1; begin < end; )
+		{
+			size_t count = end - begin;
+			if (count < MIN_NODES_PER_TASK)
+				updateRange(begin, end);
+			else
+				pool.parallelFor(count, [&](size_t first, size_t last) { updateRange(begin + first, begin + last); }, MIN_NODES_PER_TASK);
+
+			updated += count;
+			size_t nextBegin = childBegin[begin];
+			end = childEnd[end - 1];
+			begin = nextBegin;
+		}
+
+		return updated;
+	}
+
+	void TransformHierarchy::update()
+	{
+		if (orderDirty)
+			rebuild();
+
+		lastUpdatedCount = 0;
+		if (dirtySlots.empty())
+			return;
+
+		if (dirtySlots.size() * FULL_PASS_RATIO > slotToNode.size())
+		{
+			updateLevels();
+			dirtySlots.clear();
+			return;
+		}
+
+		/* Dirty nodes under a dirty ancestor are covered by the ancestor's subtree. */
+		for (uint32_t slot : dirtySlots)
+		{
+			bool coveredByAncestor = false;
+			for (uint32_t ancestor = parents[slot]; ancestor != NO_PARENT && !coveredByAncestor; ancestor = parents[ancestor])
+				coveredByAncestor = dirty[ancestor];
+
+			if (!coveredByAncestor)
+				lastUpdatedCount += updateSubtree(slot);
+		}
+
+		for (uint32_t slot : dirtySlots)
+			dirty[slot] = 0;
+		dirtySlots.clear();
+	}
+}
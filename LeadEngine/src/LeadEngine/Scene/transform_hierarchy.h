@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+
+#include "LeadEngine/core.h"
+#include "LeadEngine/slot_map.h"
+#include "LeadEngine/Math/mat4.h"
+
+namespace le
+{
+	struct LocalTransform
+	{
+		float position[3] = { 0.0f, 0.0f, 0.0f };
+		/* Unit quaternion x, y, z, w. */
+		float rotation[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+		float scale[3] = { 1.0f, 1.0f, 1.0f };
+	};
+
+	struct TransformNode;
+
+	/* Scene transforms stored in flat arrays in breadth first order: every parent sits before
+	   its children, each depth level is one contiguous range and a node's children are
+	   contiguous within the next level, so any subtree is one range per level. Changing a
+	   transform only marks it dirty; update() recomputes just the dirty nodes and their
+	   descendants, so a frame costs O(dirty), and large ranges are split across the engine
+	   thread pool.
+
+	   Nodes are referred to by generational handles. A destroyed node's handle stays invalid
+	   after its index is reused, so it cannot alias the new node. */
+	class LE_API TransformHierarchy
+	{
+	public:
+		using NodeId = Handle<TransformNode>;
+		static constexpr NodeId INVALID_NODE = NodeId();
+	private:
+		static constexpr uint32_t NO_PARENT = 0xFFFFFFFF;
+		static constexpr uint32_t NO_SLOT = 0xFFFFFFFF;
+
+		void rebuild();
+		void markDirty(uint32_t slot);
+		void updateRange(size_t begin, size_t end);
+		void updateLevels();
+		size_t updateSubtree(uint32_t root);
+
+		/* Indexed by slot, the position in breadth first order. */
+		std::vector<LocalTransform> locals;
+		std::vector<Mat4> worlds;
+		std::vector<uint32_t> parents;
+		/* Children of a slot are [childBegin, childEnd) in the next level. */
+		std::vector<uint32_t> childBegin, childEnd;
+		std::vector<uint8_t> dirty;
+		std::vector<uint8_t> removed;
+		std::vector<uint32_t> slotToNode;
+
+		/* Indexed by NodeId::index. Generations are odd while the node exists. */
+		std::vector<uint32_t> nodeToSlot;
+		std::vector<uint32_t> generations;
+		std::vector<uint32_t> freeNodes;
+
+		/* levelStarts[d] is the first slot at depth d, with a trailing end entry. */
+		std::vector<size_t> levelStarts;
+
+		/* Slots whose dirty flag was set since the last update(), each listed once. */
+		std::vector<uint32_t> dirtySlots;
+
+		bool orderDirty = false;
+		size_t lastUpdatedCount = 0;
+	public:
+		TransformHierarchy();
+
+		/* Returns INVALID_NODE if parent is stale. */
+		NodeId createNode(NodeId parent = INVALID_NODE, const LocalTransform& local = LocalTransform());
+
+		/* Destroys the node and all of its descendants. Takes effect on the next update().
+		   Returns false for stale nodes. */
+		bool destroyNode(NodeId node);
+		/* Returns false and leaves the hierarchy unchanged if either node is stale or parent is
+		   node or one of its descendants. */
+		bool setParent(NodeId node, NodeId parent);
+
+		/* Returns false for stale nodes. */
+		bool setLocal(NodeId node, const LocalTransform& local);
+		inline const LocalTransform& getLocal(NodeId node) const
+		{
+			LE_CORE_ASSERT(isValid(node), "Invalid node!");
+			return locals[nodeToSlot[node.index]];
+		}
+
+		/* Valid as of the last update(). */
+		inline const Mat4& getWorld(NodeId node) const
+		{
+			LE_CORE_ASSERT(isValid(node), "Invalid node!");
+			return worlds[nodeToSlot[node.index]];
+		}
+
+		NodeId getParent(NodeId node) const;
+		bool isValid(NodeId node) const;
+
+		void update();
+
+		inline size_t getNodeCount() const { return slotToNode.size(); }
+		inline size_t getDepthCount() const { return levelStarts.empty() ? 0 : levelStarts.size() - 1; }
+		inline size_t getLastUpdatedCount() const { return lastUpdatedCount; }
+	};
+}
@@ -0,0 +1,105 @@
+#include "le_pch.h"
+
+#include "LeadEngine/Text/glyph_atlas.h"
+
+namespace le
+{
+	/* Gap between glyphs so bilinear filtering does not bleed neighbours in. */
+	static const uint16_t PADDING = 1;
+
+	GlyphAtlas::GlyphAtlas(uint16_t width, uint16_t height)
+		: width(width), height(height), pixels((size_t)width * height, 0)
+	{
+		dirtyMinX = dirtyMinY = 0xFFFF;
+		dirtyMaxX = dirtyMaxY = 0;
+	}
+
+	GlyphAtlas::AllocateResult GlyphAtlas::allocate(uint16_t glyphWidth, uint16_t glyphHeight, uint64_t key, uint64_t frame, AtlasRect& rect, uint32_t& shelf, std::vector<uint64_t>& evicted)
+	{
+		/* In 32 bits, so a glyph near 65535 pixels cannot wrap around and appear to fit. */
+		uint32_t w = (uint32_t)glyphWidth + PADDING;
+		uint32_t h = (uint32_t)glyphHeight + PADDING;
+
+		if (w > width || h > height)
+			return TOO_LARGE;
+
+		/* Tightest existing shelf with room, ignoring shelves that would waste over a third. */
+		uint32_t best = NO_SHELF;
+		for (uint32_t i = 0; i < shelves.size(); i++)
+		{
+			const Shelf& s = shelves[i];
+			if (s.height < h || s.height * 2 > h * 3 || s.cursor + w > width)
+				continue;
+			if (best == NO_SHELF || s.height < shelves[best].height)
+				best = i;
+		}
+
+		if (best == NO_SHELF && nextShelfY + h <= height)
+		{
+			shelves.push_back({ nextShelfY, (uint16_t)h, 0, frame, {} });
+			nextShelfY += (uint16_t)h;
+			best = (uint32_t)shelves.size() - 1;
+		}
+
+		if (best == NO_SHELF)
+		{
+			/* Evict the least recently used shelf that is tall enough. */
+			for (uint32_t i = 0; i < shelves.size(); i++)
+			{
+				const Shelf& s = shelves[i];
+				if (s.height < h || s.lastUsed >= frame)
+					continue;
+				if (best == NO_SHELF || s.lastUsed < shelves[best].lastUsed)
+					best = i;
+			}
+
+			if (best == NO_SHELF)
+				return FULL;
+
+			Shelf& s = shelves[best];
+			evicted.insert(evicted.end(), s.keys.begin(), s.keys.end());
+			s.keys.clear();
+			s.cursor = 0;
+
+			/* Clear the old glyphs so none of their texels are left in the new glyphs' gutters. */
+			std::fill(pixels.begin() + (size_t)s.y * width, pixels.begin() + (size_t)(s.y + s.height) * width, 0);
+			markDirty({ 0, s.y, width, s.height });
+		}
+
+		Shelf& s = shelves[best];
+		rect = { s.cursor, s.y, glyphWidth, glyphHeight };
+		s.cursor += (uint16_t)w;
+		s.lastUsed = frame;
+		s.keys.push_back(key);
+
+		shelf = best;
+		return ALLOCATED;
+	}
+
+	void GlyphAtlas::write(const AtlasRect& rect, const uint8_t* coverage)
+	{
+		for (uint16_t y = 0; y < rect.height; y++)
+			std::copy(coverage + (size_t)y * rect.width, coverage + (size_t)(y + 1) * rect.width, &pixels[(size_t)(rect.y + y) * width + rect.x]);
+
+		markDirty(rect);
+	}
+
+	void GlyphAtlas::markDirty(const AtlasRect& rect)
+	{
+		dirtyMinX = std::min(dirtyMinX, rect.x);
+		dirtyMinY = std::min(dirtyMinY, rect.y);
+		dirtyMaxX = std::max<uint16_t>(dirtyMaxX, rect.x + rect.width);
+		dirtyMaxY = std::max<uint16_t>(dirtyMaxY, rect.y + rect.height);
+	}
+
+	bool GlyphAtlas::takeDirtyRect(AtlasRect& rect)
+	{
+		if (dirtyMinX >= dirtyMaxX || dirtyMinY >= dirtyMaxY)
+			return false;
+
+		rect = { dirtyMinX, dirtyMinY, (uint16_t)(dirtyMaxX - dirtyMinX), (uint16_t)(dirtyMaxY - dirtyMinY) };
+		dirtyMinX = dirtyMinY = 0xFFFF;
+		dirtyMaxX = dirtyMaxY = 0;
+		return true;
+	}
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+
+#include "LeadEngine/core.h"
+
+namespace le
+{
+	struct AtlasRect
+	{
+		uint16_t x = 0, y = 0, width = 0, height = 0;
+	};
+
+	/* Single channel texture atlas packed in shelves: rows of glyphs of similar height.
+	   Space is reclaimed a whole shelf at a time, evicting the least recently used shelf. */
+	class LE_API GlyphAtlas
+	{
+	private:
+		struct Shelf
+		{
+			uint16_t y, height, cursor;
+			uint64_t lastUsed;
+			std::vector<uint64_t> keys;
+		};
+
+		uint16_t width, height;
+		std::vector<uint8_t> pixels;
+		std::vector<Shelf> shelves;
+		uint16_t nextShelfY = 0;
+
+		/* Region written since the last takeDirtyRect(), for partial texture uploads. */
+		uint16_t dirtyMinX, dirtyMinY, dirtyMaxX, dirtyMaxY;
+
+		void markDirty(const AtlasRect& rect);
+	public:
+		static constexpr uint32_t NO_SHELF = 0xFFFFFFFF;
+
+		enum AllocateResult
+		{
+			ALLOCATED,
+			/* Every shelf tall enough was used this frame; may succeed in a later frame. */
+			FULL,
+			/* Larger than the atlas itself, so it will never fit. */
+			TOO_LARGE
+		};
+
+		GlyphAtlas(uint16_t width, uint16_t height);
+
+		/* Finds room for a width x height glyph identified by key. If the atlas is full, evicts
+		   the least recently used shelf not used in frame and appends its keys to evicted. */
+		AllocateResult allocate(uint16_t width, uint16_t height, uint64_t key, uint64_t frame, AtlasRect& rect, uint32_t& shelf, std::vector<uint64_t>& evicted);
+
+		inline void touch(uint32_t shelf, uint64_t frame) { shelves[shelf].lastUsed = frame; }
+
+		/* Copies a tightly packed coverage bitmap into rect. */
+		void write(const AtlasRect& rect, const uint8_t* coverage);
+
+		/* Returns false if nothing changed since the last call. */
+		bool takeDirtyRect(AtlasRect& rect);
+
+		inline uint16_t getWidth() const { return width; }
+		inline uint16_t getHeight() const { return height; }
+		inline const uint8_t* getPixels() const { return pixels.data(); }
+		inline size_t getShelfCount() const { return shelves.size(); }
+	};
+}
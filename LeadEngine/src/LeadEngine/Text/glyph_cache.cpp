@@ -0,0 +1,129 @@
+#include "le_pch.h"
+
+#include "LeadEngine/Text/glyph_cache.h"
+#include "LeadEngine/thread_pool.h"
+
+namespace le
+{
+	GlyphCache::GlyphCache(const GlyphSource& source, uint16_t atlasWidth, uint16_t atlasHeight)
+		: source(source), atlas(atlasWidth, atlasHeight)
+	{
+	}
+
+	GlyphCache::~GlyphCache()
+	{
+		waitForPending();
+	}
+
+	const GlyphInfo* GlyphCache::get(uint32_t codepoint, uint16_t pixelSize)
+	{
+		uint64_t key = makeKey(codepoint, pixelSize);
+
+		auto found = glyphs.find(key);
+		if (found != glyphs.end())
+		{
+			GlyphInfo& info = found->second;
+			if (!info.ready)
+				return nullptr;
+
+			stats.hits++;
+			if (info.shelf != GlyphAtlas::NO_SHELF)
+				atlas.touch(info.shelf, frame);
+			return &info;
+		}
+
+		stats.misses++;
+		glyphs.emplace(key, GlyphInfo());
+
+		{
+			std::lock_guard<std::mutex> lock(completedMutex);
+			inFlight++;
+		}
+
+		ThreadPool::get().submit([this, key, codepoint, pixelSize]()
+		{
+			Completed result;
+			result.key = key;
+			if (!source.rasterize(codepoint, pixelSize, result.bitmap))
+				result.bitmap = GlyphBitmap();
+
+			std::lock_guard<std::mutex> lock(completedMutex);
+			completed.push_back(std::move(result));
+			inFlight--;
+			completedCondition.notify_all();
+		});
+
+		return nullptr;
+	}
+
+	void GlyphCache::place(Completed& glyph)
+	{
+		/* Blank glyphs such as spaces only need metrics. */
+		if (glyph.bitmap.width == 0 || glyph.bitmap.height == 0)
+		{
+			GlyphInfo& info = glyphs[glyph.key];
+			info.metrics = glyph.bitmap.metrics;
+			info.ready = true;
+			return;
+		}
+
+		std::vector<uint64_t> evicted;
+		AtlasRect rect;
+		uint32_t shelf;
+		GlyphAtlas::AllocateResult result = atlas.allocate(glyph.bitmap.width, glyph.bitmap.height, glyph.key, frame, rect, shelf, evicted);
+		if (result == GlyphAtlas::FULL)
+		{
+			deferred.push_back(std::move(glyph));
+			return;
+		}
+
+		if (result == GlyphAtlas::TOO_LARGE)
+		{
+			/* Retrying would never succeed, so draw it blank like a space rather than defer it forever. */
+			LE_CORE_WARN("Glyph {0} at {1}px is {2}x{3}, larger than the {4}x{5} atlas; drawing it blank",
+				(uint32_t)glyph.key, (uint16_t)(glyph.key >> 32), glyph.bitmap.width, glyph.bitmap.height, atlas.getWidth(), atlas.getHeight());
+
+			GlyphInfo& info = glyphs[glyph.key];
+			info.metrics = glyph.bitmap.metrics;
+			info.ready = true;
+			return;
+		}
+
+		for (uint64_t key : evicted)
+			glyphs.erase(key);
+		stats.evictions += evicted.size();
+
+		atlas.write(rect, glyph.bitmap.coverage.data());
+
+		GlyphInfo& info = glyphs[glyph.key];
+		info.metrics = glyph.bitmap.metrics;
+		info.rect = rect;
+		info.shelf = shelf;
+		info.ready = true;
+	}
+
+	void GlyphCache::update()
+	{
+		frame++;
+
+		std::vector<Completed> batch;
+		batch.swap(deferred);
+		{
+			std::lock_guard<std::mutex> lock(completedMutex);
+			stats.rasterized += completed.size();
+			batch.reserve(batch.size() + completed.size());
+			for (Completed& glyph : completed)
+				batch.push_back(std::move(glyph));
+			completed.clear();
+		}
+
+		for (Completed& glyph : batch)
+			place(glyph);
+	}
+
+	void GlyphCache::waitForPending()
+	{
+		std::unique_lock<std::mutex> lock(completedMutex);
+		completedCondition.wait(lock, [this]() { return inFlight == 0; });
+	}
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <condition_variable>
+
+#include "LeadEngine/core.h"
+#include "LeadEngine/Text/glyph_source.h"
+#include "LeadEngine/Text/glyph_atlas.h"
+
+namespace le
+{
+	struct GlyphInfo
+	{
+		AtlasRect rect;
+		GlyphMetrics metrics;
+		uint32_t shelf = GlyphAtlas::NO_SHELF;
+		bool ready = false;
+	};
+
+	struct GlyphCacheStats
+	{
+		uint64_t hits = 0, misses = 0, rasterized = 0, evictions = 0;
+
+		inline float getHitRate() const { return hits + misses ? (float)hits / (float)(hits + misses) : 0.0f; }
+	};
+
+	/* Glyphs rasterized on demand into a GlyphAtlas. Misses are rasterized on the thread pool
+	   and packed into the atlas by update() on the owning thread, so get() never blocks: a
+	   glyph is skipped until its bitmap has arrived, usually on the next frame. */
+	class LE_API GlyphCache
+	{
+	private:
+		const GlyphSource& source;
+		GlyphAtlas atlas;
+		std::unordered_map<uint64_t, GlyphInfo> glyphs;
+		uint64_t frame = 1;
+		GlyphCacheStats stats;
+
+		struct Completed
+		{
+			uint64_t key;
+			GlyphBitmap bitmap;
+		};
+
+		std::mutex completedMutex;
+		std::condition_variable completedCondition;
+		std::vector<Completed> completed;
+		size_t inFlight = 0;
+
+		/* Completed bitmaps that found the atlas full, retried next update. */
+		std::vector<Completed> deferred;
+
+		static inline uint64_t makeKey(uint32_t codepoint, uint16_t pixelSize) { return ((uint64_t)pixelSize << 32) | codepoint; }
+
+		void place(Completed& glyph);
+	public:
+		GlyphCache(const GlyphSource& source, uint16_t atlasWidth = 1024, uint16_t atlasHeight = 1024);
+		~GlyphCache();
+
+		GlyphCache(const GlyphCache&) = delete;
+		GlyphCache& operator=(const GlyphCache&) = delete;
+
+		/* Returns the glyph if it is in the atlas, otherwise queues it and returns nullptr.
+		   The pointer is valid until the next update(). */
+		const GlyphInfo* get(uint32_t codepoint, uint16_t pixelSize);
+
+		/* Starts a new frame and packs glyphs finished since the last call into the atlas.
+		   Call once per frame before drawing text; glyphs returned by get() stay in the
+		   atlas until the following update(). */
+		void update();
+
+		/* Blocks until every queued glyph has been rasterized. The results are packed by the next update(). */
+		void waitForPending();
+
+		inline const GlyphSource& getSource() const { return source; }
+		inline GlyphAtlas& getAtlas() { return atlas; }
+		inline size_t getGlyphCount() const { return glyphs.size(); }
+		/* Keyed by pixel size << 32 | codepoint. Entries that are not ready are still being rasterized. */
+		inline const std::unordered_map<uint64_t, GlyphInfo>& getGlyphs() const { return glyphs; }
+		inline const GlyphCacheStats& getStats() const { return stats; }
+		inline void resetStats() { stats = GlyphCacheStats(); }
+	};
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+
+#include "LeadEngine/core.h"
+
+namespace le
+{
+	struct GlyphMetrics
+	{
+		/* Offset from the pen position on the baseline to the bitmap's top left, y up. */
+		int16_t bearingX = 0, bearingY = 0;
+		float advance = 0.0f;
+	};
+
+	struct GlyphBitmap
+	{
+		uint16_t width = 0, height = 0;
+		/* Single channel coverage, width * height, no row padding. */
+		std::vector<uint8_t> coverage;
+		GlyphMetrics metrics;
+	};
+
+	/* Produces glyph metrics and coverage bitmaps. Called from worker threads, so
+	   implementations must be safe to call concurrently. */
+	class LE_API GlyphSource
+	{
+	public:
+		virtual ~GlyphSource() {}
+
+		virtual GlyphMetrics getMetrics(uint32_t codepoint, uint16_t pixelSize) const = 0;
+		virtual float getLineHeight(uint16_t pixelSize) const = 0;
+
+		/* Returns false if the source has no glyph for codepoint. */
+		virtual bool rasterize(uint32_t codepoint, uint16_t pixelSize, GlyphBitmap& out) const = 0;
+	};
+
+	/* Built in 5x7 bitmap font covering printable ASCII, scaled by whole pixels. Always
+	   available, so debug text works without loading any assets. */
+	class LE_API DebugFont : public GlyphSource
+	{
+	public:
+		GlyphMetrics getMetrics(uint32_t codepoint, uint16_t pixelSize) const override;
+		float getLineHeight(uint16_t pixelSize) const override;
+		bool rasterize(uint32_t codepoint, uint16_t pixelSize, GlyphBitmap& out) const override;
+	};
+}
@@ -0,0 +1,124 @@
+#include "le_pch.h"
+
+#include "LeadEngine/Text/text_renderer.h"
+
+namespace le
+{
+	/* Decodes one UTF-8 sequence starting at i and advances i. Malformed input yields U+FFFD. */
+	static uint32_t decodeUtf8(const std::string& text, size_t& i)
+	{
+		uint8_t lead = (uint8_t)text[i++];
+		if (lead < 0x80)
+			return lead;
+
+		size_t extra = lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC0 ? 1 : 0;
+		if (extra == 0 || i + extra > text.size())
+			return 0xFFFD;
+
+		uint32_t codepoint = lead & (0x3F >> extra);
+		for (size_t n = 0; n < extra; n++)
+		{
+			uint8_t next = (uint8_t)text[i];
+			if ((next & 0xC0) != 0x80)
+				return 0xFFFD;
+			codepoint = (codepoint << 6) | (next & 0x3F);
+			i++;
+		}
+		return codepoint;
+	}
+
+	TextRenderer::TextRenderer(GlyphCache& cache, size_t runCapacity, size_t maxQuadsPerBatch)
+		: cache(cache), runCapacity(std::max<size_t>(runCapacity, 1)), maxQuadsPerBatch(std::max<size_t>(maxQuadsPerBatch, 1))
+	{
+	}
+
+	void TextRenderer::begin()
+	{
+		quads.clear();
+		cache.update();
+	}
+
+	const ShapedRun& TextRenderer::shape(const std::string& text, uint16_t pixelSize)
+	{
+		keyScratch.assign(text);
+		keyScratch.push_back((char)(pixelSize & 0xFF));
+		keyScratch.push_back((char)(pixelSize >> 8));
+
+		auto found = runLookup.find(keyScratch);
+		if (found != runLookup.end())
+		{
+			stats.runHits++;
+			runs.splice(runs.begin(), runs, found->second);
+			return found->second->second;
+		}
+
+		stats.runMisses++;
+		if (runs.size() >= runCapacity)
+		{
+			runLookup.erase(runs.back().first);
+			runs.pop_back();
+		}
+
+		runs.emplace_front(keyScratch, ShapedRun());
+		runLookup.emplace(keyScratch, runs.begin());
+		ShapedRun& run = runs.front().second;
+
+		const GlyphSource& source = cache.getSource();
+		float lineHeight = source.getLineHeight(pixelSize);
+		float penX = 0.0f, penY = 0.0f;
+
+		run.glyphs.reserve(text.size());
+		for (size_t i = 0; i < text.size();)
+		{
+			uint32_t codepoint = decodeUtf8(text, i);
+			if (codepoint == '\n')
+			{
+				penX = 0.0f;
+				penY += lineHeight;
+				continue;
+			}
+
+			run.glyphs.push_back({ codepoint, penX, penY });
+			penX += source.getMetrics(codepoint, pixelSize).advance;
+			run.width = std::max(run.width, penX);
+		}
+		run.height = penY + lineHeight;
+
+		return run;
+	}
+
+	std::pair<float, float> TextRenderer::drawText(const std::string& text, float x, float y, uint16_t pixelSize, uint32_t color)
+	{
+		const ShapedRun& run = shape(text, pixelSize);
+
+		GlyphAtlas& atlas = cache.getAtlas();
+		float invWidth = 1.0f / atlas.getWidth();
+		float invHeight = 1.0f / atlas.getHeight();
+
+		for (const ShapedRun::Glyph& glyph : run.glyphs)
+		{
+			const GlyphInfo* info = cache.get(glyph.codepoint, pixelSize);
+			if (!info)
+			{
+				stats.pendingGlyphs++;
+				continue;
+			}
+			if (info->rect.width == 0)
+				continue;
+
+			TextQuad quad;
+			quad.x0 = x + glyph.x + info->metrics.bearingX;
+			quad.y0 = y + glyph.y - info->metrics.bearingY;
+			quad.x1 = quad.x0 + info->rect.width;
+			quad.y1 = quad.y0 + info->rect.height;
+			quad.u0 = info->rect.x * invWidth;
+			quad.v0 = info->rect.y * invHeight;
+			quad.u1 = (info->rect.x + info->rect.width) * invWidth;
+			quad.v1 = (info->rect.y + info->rect.height) * invHeight;
+			quad.color = color;
+			quads.push_back(quad);
+		}
+
+		return { run.width, run.height };
+	}
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+
+#include "LeadEngine/core.h"
+#include "LeadEngine/Text/glyph_cache.h"
+
+namespace le
+{
+	/* Screen space quad, y down, with atlas texture coordinates and RGBA8 colour. */
+	struct TextQuad
+	{
+		float x0, y0, x1, y1;
+		float u0, v0, u1, v1;
+		uint32_t color;
+	};
+
+	/* Glyph positions for a string relative to its origin, independent of the atlas. */
+	struct ShapedRun
+	{
+		struct Glyph
+		{
+			uint32_t codepoint;
+			float x, y;
+		};
+
+		std::vector<Glyph> glyphs;
+		float width = 0.0f, height = 0.0f;
+	};
+
+	struct TextRendererStats
+	{
+		uint64_t runHits = 0, runMisses = 0;
+		/* Glyphs skipped because they were still being rasterized. */
+		uint64_t pendingGlyphs = 0;
+
+		inline float getRunHitRate() const { return runHits + runMisses ? (float)runHits / (float)(runHits + runMisses) : 0.0f; }
+	};
+
+	/* Turns strings into quads over the glyph atlas. Shaped runs are kept in an LRU cache so
+	   labels redrawn every frame skip decoding and layout, and quads are collected into
+	   batches of at most maxQuadsPerBatch so a screen of labels takes a few draw calls. */
+	class LE_API TextRenderer
+	{
+	private:
+		GlyphCache& cache;
+
+		/* Key is the text followed by the pixel size, most recently used first. */
+		std::list<std::pair<std::string, ShapedRun>> runs;
+		std::unordered_map<std::string, std::list<std::pair<std::string, ShapedRun>>::iterator> runLookup;
+		size_t runCapacity;
+		std::string keyScratch;
+
+		std::vector<TextQuad> quads;
+		size_t maxQuadsPerBatch;
+		TextRendererStats stats;
+
+		const ShapedRun& shape(const std::string& text, uint16_t pixelSize);
+	public:
+		TextRenderer(GlyphCache& cache, size_t runCapacity = 1024, size_t maxQuadsPerBatch = 16384);
+
+		TextRenderer(const TextRenderer&) = delete;
+		TextRenderer& operator=(const TextRenderer&) = delete;
+
+		/* Clears the quads from the previous frame and updates the glyph cache. */
+		void begin();
+
+		/* Appends quads for UTF-8 text with its first baseline at (x, y). Returns the
+		   text's width and height. */
+		std::pair<float, float> drawText(const std::string& text, float x, float y, uint16_t pixelSize, uint32_t color = 0xFFFFFFFF);
+
+		inline const std::vector<TextQuad>& getQuads() const { return quads; }
+		inline size_t getMaxQuadsPerBatch() const { return maxQuadsPerBatch; }
+		inline size_t getBatchCount() const { return (quads.size() + maxQuadsPerBatch - 1) / maxQuadsPerBatch; }
+		inline size_t getRunCount() const { return runs.size(); }
+
+		inline const TextRendererStats& getStats() const { return stats; }
+		inline void resetStats() { stats = TextRendererStats(); }
+	};
+}
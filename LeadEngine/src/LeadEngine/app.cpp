@@ -6,9 +6,11 @@ namespace le
 {
 #define BIND_EVENT_FN(x) std::bind(&x, this, std::placeholders::_1)
 
-	App::App()
+	static const std::chrono::seconds LATENCY_LOG_INTERVAL(10);
+
+	App::App(const WindowData& properties)
 	{
-		window = std::unique_ptr<Window>(Window::create());
+		window = std::unique_ptr<Window>(Window::create(properties));
 		window->setEventCallback(BIND_EVENT_FN(App::onEvent));
 	}
 
@@ -18,9 +20,18 @@ namespace le
 
 	void App::run()
 	{
+		lastLatencyLog = EventClock::now();
+
 		while (running)
 		{
 			window->update();
+			eventLatency.onPresent(window->getPresentTime());
+
+			if (window->getPresentTime() - lastLatencyLog >= LATENCY_LOG_INTERVAL)
+			{
+				eventLatency.log();
+				lastLatencyLog = window->getPresentTime();
+			}
 
 			for (Layer* layer : layerStack)
 				layer->update();
@@ -40,16 +51,35 @@ namespace le
 			if (e.handled)
 				break;
 		}
+
+		if (e.handled)
+			eventLatency.onEventHandled(e);
+	}
+
+	LayerHandle App::pushLayer(std::unique_ptr<Layer> layer)
+	{
+		return layerStack.pushLayer(std::move(layer));
 	}
 
-	void App::pushLayer(Layer* layer)
+	LayerHandle App::pushOverlay(std::unique_ptr<Layer> overlay)
 	{
-		layerStack.pushLayer(layer);
+		return layerStack.pushOverlay(std::move(overlay));
 	}
 
-	void App::pushOverlay(Layer* overlay)
+	std::unique_ptr<Layer> App::popLayer(LayerHandle layer)
 	{
-		layerStack.pushOverlay(overlay);
+		return layerStack.popLayer(layer);
+	}
+
+	std::unique_ptr<Layer> App::popOverlay(LayerHandle overlay)
+	{
+		return layerStack.popOverlay(overlay);
+	}
+
+	void App::close(int exitCode)
+	{
+		this->exitCode = exitCode;
+		running = false;
 	}
 
 	bool App::onWindowClose(WindowCloseEvent& e)
@@ -3,6 +3,7 @@
 #include "LeadEngine/core.h"
 #include "LeadEngine/window.h"
 #include "LeadEngine/event.h"
+#include "LeadEngine/event_latency.h"
 #include "LeadEngine/layer.h"
 
 namespace le
@@ -14,21 +15,32 @@ namespace le
 
 		std::unique_ptr<Window> window;
 		bool running = true;
+		int exitCode = 0;
 		LayerStack layerStack;
+		EventLatencyTracker eventLatency;
+		EventClock::time_point lastLatencyLog;
 	public:
-		App();
+		App(const WindowData& properties = WindowData());
 		virtual ~App();
 
 		void run();
 
+		/* Ends run() after the current frame. exitCode is returned from main. */
+		void close(int exitCode = 0);
+		inline int getExitCode() const { return exitCode; }
+
 		void onEvent(Event& e);
 
-		void pushLayer(Layer* layer);
-		void pushOverlay(Layer* overlay);
+		LayerHandle pushLayer(std::unique_ptr<Layer> layer);
+		LayerHandle pushOverlay(std::unique_ptr<Layer> overlay);
+		std::unique_ptr<Layer> popLayer(LayerHandle layer);
+		std::unique_ptr<Layer> popOverlay(LayerHandle overlay);
+
+		inline EventLatencyTracker& getEventLatency() { return eventLatency; }
 	};
 
-	/* Defined in the client. */
-	App* create_app();
+	/* Defined in the client, receives the command line. */
+	App* create_app(int argc, char** argv);
 }
 
 
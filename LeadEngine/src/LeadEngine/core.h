@@ -6,13 +6,18 @@
 	#else
 		#define LE_API __declspec(dllimport)
 	#endif
+	#define LE_DEBUGBREAK() __debugbreak()
+#elif defined(LE_PLATFORM_LINUX)
+	/* Headless builds only: no window or GL context, rendering goes through the software backend. */
+	#define LE_API __attribute__((visibility("default")))
+	#define LE_DEBUGBREAK() __builtin_trap()
 #else
-	#error Lead Engine only supports Windows.
+	#error Lead Engine only supports Windows and headless Linux.
 #endif
 
 #ifdef LE_ENABLE_ASSERTS
-	#define LE_ASSERT(x, ...) { if(!(x)) { LE_ERROR("Assertion failed: {0}", __VA_ARGS__); __debugbreak(); } }
-	#define LE_CORE_ASSERT(x, ...) { if(!(x)) { LE_ERROR("Assertion failed: {0}", __VA_ARGS__); __debugbreak(); } }
+	#define LE_ASSERT(x, ...) { if(!(x)) { LE_ERROR("Assertion failed: {0}", __VA_ARGS__); LE_DEBUGBREAK(); } }
+	#define LE_CORE_ASSERT(x, ...) { if(!(x)) { LE_ERROR("Assertion failed: {0}", __VA_ARGS__); LE_DEBUGBREAK(); } }
 #else
 	#define LE_ASSERT(x, ...)
 	#define LE_CORE_ASSERT(x, ...)
@@ -1,8 +1,8 @@
 #pragma once
 
-#ifdef LE_PLATFORM_WINDOWS
+#if defined(LE_PLATFORM_WINDOWS) || defined(LE_PLATFORM_LINUX)
 
-extern le::App* le::create_app();
+extern le::App* le::create_app(int argc, char** argv);
 
 int main(int argc, char** argv)
 {
@@ -10,8 +10,11 @@ int main(int argc, char** argv)
 	LE_CORE_WARN("Initialised log.");
 	LE_INFO("Hi I'm the App!");
 
-	auto app = le::create_app();
+	auto app = le::create_app(argc, argv);
 	app->run();
+	int exitCode = app->getExitCode();
 	delete app;
+
+	return exitCode;
 }
 #endif
\ No newline at end of file
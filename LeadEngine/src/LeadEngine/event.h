@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+
 #include "LeadEngine/core.h"
 
 namespace le
@@ -22,17 +24,23 @@ namespace le
 		EVENT_MOUSE_BTN = 16,
 	};
 
-#define EVENT_CLASS_TYPE(type) static EventType getStaticType() { return EventType::##type; }\
+#define EVENT_CLASS_TYPE(type) static EventType getStaticType() { return EventType::type; }\
 							   virtual EventType getEventType() const override { return getStaticType(); }\
 							   virtual const char* getName() const override { return #type; }
 
 #define EVENT_CLASS_CATEGORY(category) virtual int getCategoryFlags() const override { return category; }
 
+	using EventClock = std::chrono::steady_clock;
+
 	class LE_API Event
 	{
 	public:
 		bool handled = false;
 
+		/* Stamped when the platform backend creates the event and when the App sees it handled. */
+		EventClock::time_point timestamp = EventClock::now();
+		EventClock::time_point handledTimestamp;
+
 		virtual EventType getEventType() const = 0;
 		virtual const char* getName() const = 0;
 		virtual int getCategoryFlags() const = 0;
@@ -0,0 +1,131 @@
+#include "le_pch.h"
+
+#include "LeadEngine/event_latency.h"
+
+#include <cmath>
+
+namespace le
+{
+	static size_t bucketIndex(double micros)
+	{
+		if (micros <= 1.0)
+			return 0;
+
+		size_t index = (size_t)(std::log2(micros) * 4.0) + 1;
+		return std::min(index, LatencyHistogram::BUCKET_COUNT - 1);
+	}
+
+	static double bucketUpperMicros(size_t index)
+	{
+		return index == 0 ? 1.0 : std::exp2(index / 4.0);
+	}
+
+	void LatencyHistogram::record(double micros)
+	{
+		buckets[bucketIndex(micros)]++;
+		count++;
+		maxMicros = std::max(maxMicros, micros);
+	}
+
+	void LatencyHistogram::reset()
+	{
+		buckets.fill(0);
+		count = 0;
+		maxMicros = 0.0;
+	}
+
+	double LatencyHistogram::percentileMs(double fraction) const
+	{
+		if (count == 0)
+			return 0.0;
+
+		uint64_t target = (uint64_t)std::ceil(fraction * count);
+		uint64_t seen = 0;
+
+		for (size_t i = 0; i < BUCKET_COUNT; i++)
+		{
+			seen += buckets[i];
+			if (seen >= target && seen > 0)
+				return std::min(bucketUpperMicros(i), maxMicros) / 1000.0;
+		}
+
+		return maxMicros / 1000.0;
+	}
+
+	EventLatencyTracker::TypeLatency& EventLatencyTracker::getTypeLatency(const Event& e)
+	{
+		auto i = latencies.find(e.getEventType());
+		if (i == latencies.end())
+			i = latencies.emplace(e.getEventType(), TypeLatency{ e.getName(), LatencyHistogram(), LatencyHistogram() }).first;
+
+		return i->second;
+	}
+
+	void EventLatencyTracker::onEventHandled(Event& e)
+	{
+		onEventHandled(e, EventClock::now());
+	}
+
+	void EventLatencyTracker::onEventHandled(Event& e, EventClock::time_point handledTime)
+	{
+		e.handledTimestamp = handledTime;
+
+		double micros = std::chrono::duration<double, std::micro>(e.handledTimestamp - e.timestamp).count();
+		getTypeLatency(e).toHandled.record(micros);
+
+		pending.push_back({ e.getEventType(), e.timestamp, e.handledTimestamp });
+	}
+
+	void EventLatencyTracker::onPresent(EventClock::time_point presentTime)
+	{
+		auto i = std::remove_if(pending.begin(), pending.end(), [&](const PendingEvent& p)
+			{
+				if (p.handled > presentTime)
+					return false;
+
+				double micros = std::chrono::duration<double, std::micro>(presentTime - p.created).count();
+				latencies[p.type].toPresent.record(micros);
+				return true;
+			});
+
+		pending.erase(i, pending.end());
+	}
+
+	void EventLatencyTracker::reset()
+	{
+		for (auto& [type, latency] : latencies)
+		{
+			latency.toHandled.reset();
+			latency.toPresent.reset();
+		}
+
+		/* Otherwise events handled before the reset would be counted by the next present. */
+		pending.clear();
+	}
+
+	void EventLatencyTracker::log() const
+	{
+		for (const auto& [type, latency] : latencies)
+		{
+			if (latency.toHandled.getCount() == 0)
+				continue;
+
+			LE_CORE_INFO("{0} latency ({1} events): handled p50 {2:.3f} ms p99 {3:.3f} ms, present p50 {4:.3f} ms p99 {5:.3f} ms",
+				latency.name, latency.toHandled.getCount(),
+				latency.toHandled.percentileMs(0.5), latency.toHandled.percentileMs(0.99),
+				latency.toPresent.percentileMs(0.5), latency.toPresent.percentileMs(0.99));
+		}
+	}
+
+	const LatencyHistogram* EventLatencyTracker::getHandledLatency(EventType type) const
+	{
+		auto i = latencies.find(type);
+		return i == latencies.end() ? nullptr : &i->second.toHandled;
+	}
+
+	const LatencyHistogram* EventLatencyTracker::getPresentLatency(EventType type) const
+	{
+		auto i = latencies.find(type);
+		return i == latencies.end() ? nullptr : &i->second.toPresent;
+	}
+}
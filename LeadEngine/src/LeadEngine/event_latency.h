@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "LeadEngine/core.h"
+#include "LeadEngine/event.h"
+
+namespace le
+{
+	/* Log scaled histogram of microsecond latencies. Each power of two is split into 4 buckets,
+	   so percentiles are accurate to within ~19%. */
+	class LE_API LatencyHistogram
+	{
+	public:
+		static constexpr size_t BUCKET_COUNT = 128;
+	private:
+		std::array<uint64_t, BUCKET_COUNT> buckets{};
+		uint64_t count = 0;
+		double maxMicros = 0.0;
+	public:
+		void record(double micros);
+		void reset();
+
+		/* Upper bound of the bucket holding the given fraction (0 - 1) of samples, in milliseconds. */
+		double percentileMs(double fraction) const;
+
+		inline uint64_t getCount() const { return count; }
+		inline double getMaxMs() const { return maxMicros / 1000.0; }
+	};
+
+	/* Per event type input latency: creation to handled, and creation to the next buffer swap. */
+	class LE_API EventLatencyTracker
+	{
+	private:
+		struct TypeLatency
+		{
+			const char* name;
+			LatencyHistogram toHandled;
+			LatencyHistogram toPresent;
+		};
+
+		struct PendingEvent
+		{
+			EventType type;
+			EventClock::time_point created;
+			EventClock::time_point handled;
+		};
+
+		TypeLatency& getTypeLatency(const Event& e);
+
+		std::unordered_map<EventType, TypeLatency> latencies;
+		std::vector<PendingEvent> pending;
+	public:
+		/* Call once e.handled is set; records creation to handled and queues the event for onPresent. */
+		void onEventHandled(Event& e);
+		/* As above with an explicit handled time, so latencies can be checked deterministically. */
+		void onEventHandled(Event& e, EventClock::time_point handledTime);
+
+		/* Call with the time the last buffer swap completed. Resolves events handled before it. */
+		void onPresent(EventClock::time_point presentTime);
+
+		void reset();
+		void log() const;
+
+		/* Returns nullptr if no event of this type has been handled. */
+		const LatencyHistogram* getHandledLatency(EventType type) const;
+		const LatencyHistogram* getPresentLatency(EventType type) const;
+	};
+}
@@ -13,38 +13,58 @@ namespace le
 
 	LayerStack::LayerStack()
 	{
-		layerInsert = layers.begin();
 	}
 
 	LayerStack::~LayerStack()
 	{
-		for (Layer* layer : layers)
-			delete layer;
+		for (LayerHandle handle : order)
+			layers.erase(handle);
 	}
 
-	void LayerStack::pushLayer(Layer* layer)
+	LayerHandle LayerStack::pushLayer(std::unique_ptr<Layer> layer)
 	{
-		layerInsert = layers.emplace(layerInsert, layer);
+		LayerHandle handle = layers.insert(std::move(layer));
+		order.insert(order.begin() + layerInsert++, handle);
+		return handle;
 	}
-	void LayerStack::pushOverlay(Layer* overlay)
+
+	LayerHandle LayerStack::pushOverlay(std::unique_ptr<Layer> overlay)
 	{
-		layers.emplace_back(overlay);
+		LayerHandle handle = layers.insert(std::move(overlay));
+		order.push_back(handle);
+		return handle;
+	}
+
+	std::unique_ptr<Layer> LayerStack::popLayer(LayerHandle layer)
+	{
+		auto i = std::find(order.begin(), order.begin() + layerInsert, layer);
+		if (i == order.begin() + layerInsert)
+			return nullptr;
+
+		std::unique_ptr<Layer> popped = std::move(*layers.get(layer));
+		layers.erase(layer);
+		order.erase(i);
+		layerInsert--;
+
+		return popped;
 	}
-	void LayerStack::popLayer(Layer* layer)
+
+	std::unique_ptr<Layer> LayerStack::popOverlay(LayerHandle overlay)
 	{
-		auto i = std::find(layers.begin(), layers.end(), layer);
-		if (i != layers.end())
-		{
-			layers.erase(i);
-			layerInsert--;
-		}
+		auto i = std::find(order.begin() + layerInsert, order.end(), overlay);
+		if (i == order.end())
+			return nullptr;
+
+		std::unique_ptr<Layer> popped = std::move(*layers.get(overlay));
+		layers.erase(overlay);
+		order.erase(i);
+
+		return popped;
 	}
 
-	void LayerStack::popOverlay(Layer* overlay)
+	Layer* LayerStack::get(LayerHandle layer) const
 	{
-		auto i = std::find(layers.begin(), layers.end(), overlay);
-		if (i != layers.end())
-			layers.erase(i);
+		const std::unique_ptr<Layer>* slot = layers.get(layer);
+		return slot ? slot->get() : nullptr;
 	}
 }
-
@@ -2,6 +2,7 @@
 
 #include "LeadEngine/core.h"
 #include "LeadEngine/event.h"
+#include "LeadEngine/slot_map.h"
 
 namespace le
 {
@@ -21,21 +22,49 @@ namespace le
 		inline const std::string& getName() const { return debugName; }
 	};
 
+	using LayerHandle = Handle<std::unique_ptr<Layer>>;
+
 	class LE_API LayerStack
 	{
 	private:
-		std::vector<Layer*> layers;
-		std::vector<Layer*>::iterator layerInsert;
+		SlotMap<std::unique_ptr<Layer>> layers;
+		/* Draw/update order: layers first, then overlays from layerInsert onwards. */
+		std::vector<LayerHandle> order;
+		size_t layerInsert = 0;
 	public:
+		/* Walks the stack in order, yielding Layer*. */
+		class Iterator
+		{
+		private:
+			std::vector<LayerHandle>::const_iterator it;
+			const SlotMap<std::unique_ptr<Layer>>* layers;
+		public:
+			Iterator(std::vector<LayerHandle>::const_iterator it, const SlotMap<std::unique_ptr<Layer>>* layers) : it(it), layers(layers) {}
+
+			inline Layer* operator *() const { return layers->get(*it)->get(); }
+			inline Iterator& operator ++() { ++it; return *this; }
+			inline Iterator& operator --() { --it; return *this; }
+			inline bool operator ==(const Iterator& other) const { return it == other.it; }
+			inline bool operator !=(const Iterator& other) const { return it != other.it; }
+		};
+
 		LayerStack();
 		~LayerStack();
 
-		void pushLayer(Layer* layer);
-		void pushOverlay(Layer* overlay);
-		void popLayer(Layer* layer);
-		void popOverlay(Layer* overlay);
+		LayerStack(const LayerStack&) = delete;
+		LayerStack& operator =(const LayerStack&) = delete;
+
+		LayerHandle pushLayer(std::unique_ptr<Layer> layer);
+		LayerHandle pushOverlay(std::unique_ptr<Layer> overlay);
+
+		/* Hands ownership back to the caller, or returns nullptr if the handle is stale. */
+		std::unique_ptr<Layer> popLayer(LayerHandle layer);
+		std::unique_ptr<Layer> popOverlay(LayerHandle overlay);
+
+		/* Returns nullptr if the layer has been popped. */
+		Layer* get(LayerHandle layer) const;
 
-		std::vector<Layer*>::iterator begin() { return layers.begin(); }
-		std::vector<Layer*>::iterator end() { return layers.end(); }
+		Iterator begin() const { return Iterator(order.begin(), &layers); }
+		Iterator end() const { return Iterator(order.end(), &layers); }
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "LeadEngine/core.h"
+
+namespace le
+{
+	/* Weak reference into a SlotMap<T>. Stays valid while the value lives; once the value is
+	   erased the generation no longer matches and lookups fail instead of dangling. */
+	template<typename T>
+	struct Handle
+	{
+		uint32_t index = 0;
+		/* Always odd, so a default constructed handle with 0 is always invalid. */
+		uint32_t generation = 0;
+
+		inline bool isNull() const { return generation == 0; }
+
+		inline bool operator ==(const Handle& other) const { return index == other.index && generation == other.generation; }
+		inline bool operator !=(const Handle& other) const { return !(*this == other); }
+	};
+
+	/* Values are stored densely for iteration and erased by swapping in the last value, so
+	   insert, erase and lookup are all O(1). Handles are stable across other erases.
+
+	   A slot's generation is odd while it holds a value and even while it is free, so a handle
+	   can only match an occupied slot, and the null handle (generation 0) never matches. */
+	template<typename T>
+	class SlotMap
+	{
+	private:
+		struct Slot
+		{
+			/* Dense index while occupied, next free slot while free. */
+			uint32_t target;
+			/* Odd while occupied. */
+			uint32_t generation;
+		};
+
+		static constexpr uint32_t NO_SLOT = 0xFFFFFFFF;
+
+		std::vector<T> values;
+		std::vector<uint32_t> denseToSlot;
+		std::vector<Slot> slots;
+		uint32_t freeHead = NO_SLOT;
+	public:
+		template<typename... Args>
+		Handle<T> emplace(Args&&... args)
+		{
+			uint32_t index;
+			if (freeHead != NO_SLOT)
+			{
+				index = freeHead;
+				freeHead = slots[index].target;
+				slots[index].generation++;
+			}
+			else
+			{
+				index = (uint32_t)slots.size();
+				slots.push_back({ NO_SLOT, 1 });
+			}
+
+			values.emplace_back(std::forward<Args>(args)...);
+			denseToSlot.push_back(index);
+			slots[index].target = (uint32_t)values.size() - 1;
+
+			return { index, slots[index].generation };
+		}
+
+		inline Handle<T> insert(T value) { return emplace(std::move(value)); }
+
+		/* Returns false if the handle was already stale. */
+		bool erase(Handle<T> handle)
+		{
+			if (!contains(handle))
+				return false;
+
+			uint32_t dense = slots[handle.index].target;
+			uint32_t last = (uint32_t)values.size() - 1;
+
+			if (dense != last)
+			{
+				values[dense] = std::move(values[last]);
+				denseToSlot[dense] = denseToSlot[last];
+				slots[denseToSlot[dense]].target = dense;
+			}
+			values.pop_back();
+			denseToSlot.pop_back();
+
+			Slot& slot = slots[handle.index];
+			/* Even, so the slot reads as free. Wraps from 0xFFFFFFFF to 0, which is even too. */
+			slot.generation++;
+			slot.target = freeHead;
+			freeHead = handle.index;
+
+			return true;
+		}
+
+		inline bool contains(Handle<T> handle) const
+		{
+			return (handle.generation & 1) && handle.index < slots.size() && slots[handle.index].generation == handle.generation;
+		}
+
+		/* Returns nullptr for stale handles. */
+		inline T* get(Handle<T> handle) { return contains(handle) ? &values[slots[handle.index].target] : nullptr; }
+		inline const T* get(Handle<T> handle) const { return contains(handle) ? &values[slots[handle.index].target] : nullptr; }
+
+		/* Handle of the value at a dense position, for use while iterating. */
+		inline Handle<T> handleAt(size_t dense) const
+		{
+			uint32_t index = denseToSlot[dense];
+			return { index, slots[index].generation };
+		}
+
+		void clear()
+		{
+			while (!values.empty())
+				erase(handleAt(values.size() - 1));
+		}
+
+		inline size_t size() const { return values.size(); }
+		inline bool empty() const { return values.empty(); }
+
+		/* Dense iteration. Order changes when values are erased. */
+		inline typename std::vector<T>::iterator begin() { return values.begin(); }
+		inline typename std::vector<T>::iterator end() { return values.end(); }
+		inline typename std::vector<T>::const_iterator begin() const { return values.begin(); }
+		inline typename std::vector<T>::const_iterator end() const { return values.end(); }
+	};
+}
@@ -0,0 +1,102 @@
+#include "le_pch.h"
+
+#include "LeadEngine/thread_pool.h"
+
+namespace le
+{
+	ThreadPool::ThreadPool(unsigned int threadCount)
+	{
+		/* hardware_concurrency() may report 0; the caller thread always helps so keep at least one worker. */
+		if (threadCount == 0)
+			threadCount = 1;
+
+		for (unsigned int i = 0; i < threadCount; i++)
+			workers.emplace_back(&ThreadPool::workerLoop, this);
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(queueMutex);
+			stopping = true;
+		}
+		taskAvailable.notify_all();
+
+		for (std::thread& worker : workers)
+			worker.join();
+	}
+
+	void ThreadPool::workerLoop()
+	{
+		while (true)
+		{
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(queueMutex);
+				taskAvailable.wait(lock, [this] { return stopping || !tasks.empty(); });
+
+				if (stopping && tasks.empty())
+					return;
+
+				task = std::move(tasks.front());
+				tasks.pop();
+			}
+			task();
+		}
+	}
+
+	void ThreadPool::submit(std::function<void()> task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(queueMutex);
+			tasks.push(std::move(task));
+		}
+		taskAvailable.notify_one();
+	}
+
+	void ThreadPool::parallelFor(size_t count, const std::function<void(size_t begin, size_t end)>& func, size_t minRange)
+	{
+		if (count == 0)
+			return;
+
+		size_t rangeCount = std::min<size_t>(workers.size() + 1, (count + minRange - 1) / std::max<size_t>(minRange, 1));
+		if (rangeCount <= 1)
+		{
+			func(0, count);
+			return;
+		}
+
+		size_t rangeSize = (count + rangeCount - 1) / rangeCount;
+
+		std::mutex doneMutex;
+		std::condition_variable done;
+		size_t remaining = rangeCount - 1;
+
+		for (size_t r = 1; r < rangeCount; r++)
+		{
+			size_t begin = r * rangeSize;
+			size_t end = std::min(begin + rangeSize, count);
+
+			submit([&, begin, end]
+				{
+					if (begin < end)
+						func(begin, end);
+
+					std::lock_guard<std::mutex> lock(doneMutex);
+					if (--remaining == 0)
+						done.notify_one();
+				});
+		}
+
+		func(0, std::min(rangeSize, count));
+
+		std::unique_lock<std::mutex> lock(doneMutex);
+		done.wait(lock, [&] { return remaining == 0; });
+	}
+
+	ThreadPool& ThreadPool::get()
+	{
+		static ThreadPool pool;
+		return pool;
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+
+#include "LeadEngine/core.h"
+
+namespace le
+{
+	/* Fixed set of worker threads shared by engine systems. */
+	class LE_API ThreadPool
+	{
+	private:
+		void workerLoop();
+
+		std::vector<std::thread> workers;
+		std::queue<std::function<void()>> tasks;
+		std::mutex queueMutex;
+		std::condition_variable taskAvailable;
+		bool stopping = false;
+	public:
+		ThreadPool(unsigned int threadCount = std::thread::hardware_concurrency());
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator =(const ThreadPool&) = delete;
+
+		void submit(std::function<void()> task);
+
+		/* Splits [0, count) into contiguous ranges and blocks until every range has run.
+		   The calling thread works on a range too. Do not call from inside a pool task. */
+		void parallelFor(size_t count, const std::function<void(size_t begin, size_t end)>& func, size_t minRange = 1);
+
+		inline unsigned int getThreadCount() const { return (unsigned int)workers.size(); }
+
+		/* Engine wide pool, created on first use. */
+		static ThreadPool& get();
+	};
+}
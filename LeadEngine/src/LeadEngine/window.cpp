@@ -0,0 +1,21 @@
+#include "le_pch.h"
+
+#include "LeadEngine/window.h"
+#include "Platform/Headless/headless_window.h"
+
+#ifdef LE_PLATFORM_WINDOWS
+	#include "Platform/Windows/win_window.h"
+#endif
+
+namespace le
+{
+	Window* Window::create(const WindowData& properties)
+	{
+#ifdef LE_PLATFORM_WINDOWS
+		if (!properties.headless)
+			return new WinWindow(properties);
+#endif
+
+		return new HeadlessWindow(properties);
+	}
+}
@@ -12,11 +12,17 @@ namespace le
 		std::string title;
 		unsigned int width;
 		unsigned int height;
+		/* No OS window or GL context, render with the software backend. */
+		bool headless;
+		/* Headless only: send a WindowCloseEvent after this many frames, 0 runs until App::close(). */
+		unsigned int frameLimit;
 
 		WindowData(const std::string& title = "Lead Engine",
 			unsigned int width = 1280,
-			unsigned int height = 720)
-			: title(title), width(width), height(height) {}
+			unsigned int height = 720,
+			bool headless = false,
+			unsigned int frameLimit = 0)
+			: title(title), width(width), height(height), headless(headless), frameLimit(frameLimit) {}
 	};
 
 	/* Interface for a desktop based window. */
@@ -32,12 +38,15 @@ namespace le
 		virtual unsigned int getWidth() const = 0;
 		virtual unsigned int getHeight() const = 0;
 
+		/* When the most recent buffer swap completed. */
+		virtual EventClock::time_point getPresentTime() const = 0;
+
 		/* Window attributes. */
 		virtual void setEventCallback(const EventCallbackFn& callback) = 0;
 		virtual void setVSync(bool enabled) = 0;
 		virtual bool isVSync() const = 0;
 
-		/* Implemented in the .cpp file depending on the platform. */
+		/* Headless windows on every platform, otherwise the platform's window. Always headless on Linux. */
 		static Window* create(const WindowData& properties = WindowData());
 	};
 }
@@ -0,0 +1,26 @@
+#include "le_pch.h"
+
+#include "headless_window.h"
+
+namespace le
+{
+	HeadlessWindow::HeadlessWindow(const WindowData& properties) : data(properties)
+	{
+		LE_CORE_INFO("Creating headless window {0} ({1}, {2})", properties.title, properties.width, properties.height);
+	}
+
+	HeadlessWindow::~HeadlessWindow()
+	{
+	}
+
+	void HeadlessWindow::update()
+	{
+		presentTime = EventClock::now();
+
+		if (data.frameLimit != 0 && ++frameCount == data.frameLimit && eventCallback)
+		{
+			WindowCloseEvent event;
+			eventCallback(event);
+		}
+	}
+}
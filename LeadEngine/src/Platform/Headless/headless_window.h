@@ -0,0 +1,32 @@
+#pragma once
+
+#include "LeadEngine/window.h"
+
+namespace le
+{
+	/* Window with no OS window or GL context, for servers and CI. Rendering goes through the
+	   software backend instead. */
+	class HeadlessWindow : public Window
+	{
+	private:
+		WindowData data;
+		bool vSync = false;
+		EventClock::time_point presentTime;
+		EventCallbackFn eventCallback;
+		unsigned int frameCount = 0;
+	public:
+		HeadlessWindow(const WindowData& properties);
+		virtual ~HeadlessWindow();
+
+		void update() override;
+
+		inline unsigned int getWidth() const override { return data.width; }
+		inline unsigned int getHeight() const override { return data.height; }
+		inline EventClock::time_point getPresentTime() const override { return presentTime; }
+
+		/* Window attributes. */
+		inline void setEventCallback(const EventCallbackFn& callback) override { eventCallback = callback; }
+		inline void setVSync(bool enabled) override { vSync = enabled; }
+		inline bool isVSync() const override { return vSync; }
+	};
+}
@@ -0,0 +1,175 @@
+#include "le_pch.h"
+
+#ifdef LE_FAKE_GL
+
+#include "fake_gl.h"
+
+#include <atomic>
+#include <cstring>
+
+#include "glad/glad.h"
+
+namespace le
+{
+	static std::atomic<uint64_t> callCount(0);
+	static std::atomic<GLuint> nextName(1);
+
+	/* Stub with the exact signature of a Glad entry point. It only counts the call and returns
+	   a value-initialised result, so GL_NO_ERROR from glGetError and nullptr from glMapBuffer. */
+	template<typename Proc>
+	struct FakeEntry;
+
+	template<typename R, typename... Args>
+	struct FakeEntry<R (APIENTRYP)(Args...)>
+	{
+		static R APIENTRY call(Args...)
+		{
+			callCount++;
+			return R();
+		}
+	};
+
+	/* Glad reads the version and the extension list while loading. */
+	static const GLubyte* APIENTRY fakeGetString(GLenum)
+	{
+		callCount++;
+		return (const GLubyte*)"4.6.0 Fake";
+	}
+
+	static const GLubyte* APIENTRY fakeGetStringi(GLenum, GLuint)
+	{
+		callCount++;
+		return (const GLubyte*)"GL_FAKE_extension";
+	}
+
+	static void APIENTRY fakeGetIntegerv(GLenum name, GLint* value)
+	{
+		callCount++;
+		*value = name == GL_NUM_EXTENSIONS ? 1 : 0;
+	}
+
+	/* Object creation hands out distinct non-zero names. */
+	static GLuint APIENTRY fakeCreateObject()
+	{
+		callCount++;
+		return nextName++;
+	}
+
+	static GLuint APIENTRY fakeCreateShader(GLenum)
+	{
+		return fakeCreateObject();
+	}
+
+	static void APIENTRY fakeGenNames(GLsizei count, GLuint* names)
+	{
+		callCount++;
+		for (GLsizei i = 0; i < count; i++)
+			names[i] = nextName++;
+	}
+
+	/* Compile, link and info log queries report success with an empty log. */
+	static void APIENTRY fakeGetObjectiv(GLuint, GLenum name, GLint* value)
+	{
+		callCount++;
+		*value = name == GL_INFO_LOG_LENGTH ? 0 : GL_TRUE;
+	}
+
+	static GLenum APIENTRY fakeCheckFramebufferStatus(GLenum)
+	{
+		callCount++;
+		return GL_FRAMEBUFFER_COMPLETE;
+	}
+
+	struct FakeProc
+	{
+		const char* name;
+		void* proc;
+	};
+
+	#define LE_FAKE_GL_STUB(name) { #name, (void*)FakeEntry<decltype(glad_##name)>::call }
+
+	/* Entry points without a stub here load as null, so calling one fails loudly instead of
+	   going through a function pointer of the wrong type. */
+	static const FakeProc fakeProcs[] =
+	{
+		{ "glGetString", (void*)fakeGetString },
+		{ "glGetStringi", (void*)fakeGetStringi },
+		{ "glGetIntegerv", (void*)fakeGetIntegerv },
+		{ "glCreateProgram", (void*)fakeCreateObject },
+		{ "glCreateShader", (void*)fakeCreateShader },
+		{ "glGenBuffers", (void*)fakeGenNames },
+		{ "glGenVertexArrays", (void*)fakeGenNames },
+		{ "glGenTextures", (void*)fakeGenNames },
+		{ "glGenFramebuffers", (void*)fakeGenNames },
+		{ "glGetShaderiv", (void*)fakeGetObjectiv },
+		{ "glGetProgramiv", (void*)fakeGetObjectiv },
+		{ "glCheckFramebufferStatus", (void*)fakeCheckFramebufferStatus },
+		LE_FAKE_GL_STUB(glGetError),
+		LE_FAKE_GL_STUB(glMapBuffer),
+		LE_FAKE_GL_STUB(glUnmapBuffer),
+		LE_FAKE_GL_STUB(glIsEnabled),
+
+		/* Everything GLStateCache issues. */
+		LE_FAKE_GL_STUB(glUseProgram),
+		LE_FAKE_GL_STUB(glDeleteProgram),
+		LE_FAKE_GL_STUB(glBindVertexArray),
+		LE_FAKE_GL_STUB(glDeleteVertexArrays),
+		LE_FAKE_GL_STUB(glBindBuffer),
+		LE_FAKE_GL_STUB(glDeleteBuffers),
+		LE_FAKE_GL_STUB(glBindFramebuffer),
+		LE_FAKE_GL_STUB(glDeleteFramebuffers),
+		LE_FAKE_GL_STUB(glActiveTexture),
+		LE_FAKE_GL_STUB(glBindTexture),
+		LE_FAKE_GL_STUB(glBindTextureUnit),
+		LE_FAKE_GL_STUB(glDeleteTextures),
+		LE_FAKE_GL_STUB(glEnable),
+		LE_FAKE_GL_STUB(glDisable),
+		LE_FAKE_GL_STUB(glBlendFunc),
+		LE_FAKE_GL_STUB(glBlendFuncSeparate),
+		LE_FAKE_GL_STUB(glBlendEquation),
+		LE_FAKE_GL_STUB(glBlendEquationSeparate),
+		LE_FAKE_GL_STUB(glDepthFunc),
+		LE_FAKE_GL_STUB(glDepthMask),
+		LE_FAKE_GL_STUB(glColorMask),
+		LE_FAKE_GL_STUB(glCullFace),
+		LE_FAKE_GL_STUB(glFrontFace),
+		LE_FAKE_GL_STUB(glViewport),
+		LE_FAKE_GL_STUB(glScissor),
+		LE_FAKE_GL_STUB(glClearColor),
+	};
+
+	#undef LE_FAKE_GL_STUB
+
+	static void* fakeLoader(const char* name)
+	{
+		for (const FakeProc& fake : fakeProcs)
+			if (std::strcmp(name, fake.name) == 0)
+				return fake.proc;
+
+		return nullptr;
+	}
+
+	bool FakeGL::load()
+	{
+		if (!gladLoadGLLoader(fakeLoader))
+		{
+			LE_CORE_ERROR("Failed to load the fake GL function table!");
+			return false;
+		}
+
+		callCount = 0;
+		return true;
+	}
+
+	uint64_t FakeGL::getCallCount()
+	{
+		return callCount;
+	}
+
+	void FakeGL::resetCallCount()
+	{
+		callCount = 0;
+	}
+}
+
+#endif
@@ -0,0 +1,26 @@
+#pragma once
+
+#ifdef LE_FAKE_GL
+
+#include <cstdint>
+
+#include "LeadEngine/core.h"
+
+namespace le
+{
+	/* Loads Glad with a fake function table so GL code runs without a context or GPU. Each stub
+	   has the signature of the entry point it replaces, counts the call and returns a defined
+	   value; entry points without a stub stay null. This replaces the real function pointers,
+	   so it is only built with LE_FAKE_GL, which Debug defines, and only used in headless runs. */
+	class LE_API FakeGL
+	{
+	public:
+		static bool load();
+
+		/* Calls made through Glad since load() or the last reset. */
+		static uint64_t getCallCount();
+		static void resetCallCount();
+	};
+}
+
+#endif
@@ -0,0 +1,333 @@
+#include "le_pch.h"
+
+#include "gl_state_cache.h"
+
+#include <limits>
+
+namespace le
+{
+	GLStateCache::GLStateCache()
+	{
+		invalidate();
+	}
+
+	int GLStateCache::bufferSlot(GLenum target)
+	{
+		switch (target)
+		{
+			case GL_ARRAY_BUFFER: return ARRAY;
+			case GL_ELEMENT_ARRAY_BUFFER: return ELEMENT_ARRAY;
+			case GL_UNIFORM_BUFFER: return UNIFORM;
+			case GL_SHADER_STORAGE_BUFFER: return SHADER_STORAGE;
+			case GL_COPY_READ_BUFFER: return COPY_READ;
+			case GL_COPY_WRITE_BUFFER: return COPY_WRITE;
+			case GL_PIXEL_PACK_BUFFER: return PIXEL_PACK;
+			case GL_PIXEL_UNPACK_BUFFER: return PIXEL_UNPACK;
+			case GL_DRAW_INDIRECT_BUFFER: return DRAW_INDIRECT;
+			case GL_DISPATCH_INDIRECT_BUFFER: return DISPATCH_INDIRECT;
+		}
+		return -1;
+	}
+
+	int GLStateCache::textureSlot(GLenum target)
+	{
+		switch (target)
+		{
+			case GL_TEXTURE_2D: return TEX_2D;
+			case GL_TEXTURE_2D_ARRAY: return TEX_2D_ARRAY;
+			case GL_TEXTURE_3D: return TEX_3D;
+			case GL_TEXTURE_CUBE_MAP: return TEX_CUBE_MAP;
+		}
+		return -1;
+	}
+
+	int GLStateCache::capability(GLenum cap)
+	{
+		switch (cap)
+		{
+			case GL_BLEND: return BLEND;
+			case GL_DEPTH_TEST: return DEPTH_TEST;
+			case GL_CULL_FACE: return CULL_FACE;
+			case GL_SCISSOR_TEST: return SCISSOR_TEST;
+			case GL_STENCIL_TEST: return STENCIL_TEST;
+			case GL_FRAMEBUFFER_SRGB: return FRAMEBUFFER_SRGB;
+			case GL_MULTISAMPLE: return MULTISAMPLE;
+		}
+		return -1;
+	}
+
+	void GLStateCache::invalidate()
+	{
+		currentProgram = UNKNOWN;
+		currentVertexArray = UNKNOWN;
+		currentDrawFramebuffer = currentReadFramebuffer = UNKNOWN;
+		currentBuffers.fill(UNKNOWN);
+
+		currentUnit = UNKNOWN;
+		for (auto& unit : currentTextures)
+			unit.fill(UNKNOWN);
+		currentUnitTextures.fill(UNKNOWN);
+
+		currentCapabilities.fill(-1);
+		currentBlendFunc.fill(UNKNOWN);
+		currentBlendEquation.fill(UNKNOWN);
+		currentDepthFunc = UNKNOWN;
+		currentDepthMask = -1;
+		currentCullFace = UNKNOWN;
+		currentFrontFace = UNKNOWN;
+		currentColorMask.fill(-1);
+		/* Negative sizes are invalid in GL, so never match a real call. */
+		currentViewport.fill(-1);
+		currentScissor.fill(-1);
+		/* NaN never compares equal. */
+		currentClearColor.fill(std::numeric_limits<GLfloat>::quiet_NaN());
+	}
+
+	void GLStateCache::useProgram(GLuint program)
+	{
+		if (change(currentProgram, program))
+			glUseProgram(program);
+	}
+
+	void GLStateCache::bindVertexArray(GLuint vertexArray)
+	{
+		if (change(currentVertexArray, vertexArray))
+		{
+			glBindVertexArray(vertexArray);
+
+			/* The element array binding is part of the vertex array object. */
+			currentBuffers[ELEMENT_ARRAY] = UNKNOWN;
+		}
+	}
+
+	void GLStateCache::bindBuffer(GLenum target, GLuint buffer)
+	{
+		int slot = bufferSlot(target);
+		if (slot < 0)
+		{
+			stats.issued++;
+			glBindBuffer(target, buffer);
+			return;
+		}
+
+		if (change(currentBuffers[slot], buffer))
+			glBindBuffer(target, buffer);
+	}
+
+	void GLStateCache::bindFramebuffer(GLenum target, GLuint framebuffer)
+	{
+		bool issue;
+		switch (target)
+		{
+			case GL_DRAW_FRAMEBUFFER:
+				issue = change(currentDrawFramebuffer, framebuffer);
+				break;
+			case GL_READ_FRAMEBUFFER:
+				issue = change(currentReadFramebuffer, framebuffer);
+				break;
+			default:
+				issue = currentDrawFramebuffer != framebuffer || currentReadFramebuffer != framebuffer;
+				currentDrawFramebuffer = currentReadFramebuffer = framebuffer;
+				if (issue)
+					stats.issued++;
+				else
+					stats.elided++;
+		}
+
+		if (issue)
+			glBindFramebuffer(target, framebuffer);
+	}
+
+	void GLStateCache::activeTexture(GLenum unit)
+	{
+		if (change(currentUnit, unit))
+			glActiveTexture(unit);
+	}
+
+	void GLStateCache::bindTexture(GLenum target, GLuint texture)
+	{
+		GLuint unit = currentUnit - GL_TEXTURE0;
+		int slot = textureSlot(target);
+
+		if (slot < 0 || currentUnit == UNKNOWN || unit >= MAX_TEXTURE_UNITS)
+		{
+			stats.issued++;
+			glBindTexture(target, texture);
+			if (unit < MAX_TEXTURE_UNITS)
+				currentUnitTextures[unit] = UNKNOWN;
+			return;
+		}
+
+		if (change(currentTextures[unit][slot], texture))
+		{
+			glBindTexture(target, texture);
+			currentUnitTextures[unit] = UNKNOWN;
+		}
+	}
+
+	void GLStateCache::bindTextureUnit(GLuint unit, GLuint texture)
+	{
+		if (unit >= MAX_TEXTURE_UNITS)
+		{
+			stats.issued++;
+			glBindTextureUnit(unit, texture);
+			return;
+		}
+
+		if (change(currentUnitTextures[unit], texture))
+		{
+			glBindTextureUnit(unit, texture);
+			currentTextures[unit].fill(UNKNOWN);
+		}
+	}
+
+	void GLStateCache::enable(GLenum cap)
+	{
+		setEnabled(cap, true);
+	}
+
+	void GLStateCache::disable(GLenum cap)
+	{
+		setEnabled(cap, false);
+	}
+
+	void GLStateCache::setEnabled(GLenum cap, bool enabled)
+	{
+		int index = capability(cap);
+		if (index < 0)
+			stats.issued++;
+		else if (!change(currentCapabilities[index], (int8_t)enabled))
+			return;
+
+		if (enabled)
+			glEnable(cap);
+		else
+			glDisable(cap);
+	}
+
+	void GLStateCache::blendFunc(GLenum src, GLenum dst)
+	{
+		if (change(currentBlendFunc, { src, dst, src, dst }))
+			glBlendFunc(src, dst);
+	}
+
+	void GLStateCache::blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha)
+	{
+		if (change(currentBlendFunc, { srcRGB, dstRGB, srcAlpha, dstAlpha }))
+			glBlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
+	}
+
+	void GLStateCache::blendEquation(GLenum mode)
+	{
+		if (change(currentBlendEquation, { mode, mode }))
+			glBlendEquation(mode);
+	}
+
+	void GLStateCache::blendEquationSeparate(GLenum modeRGB, GLenum modeAlpha)
+	{
+		if (change(currentBlendEquation, { modeRGB, modeAlpha }))
+			glBlendEquationSeparate(modeRGB, modeAlpha);
+	}
+
+	void GLStateCache::depthFunc(GLenum func)
+	{
+		if (change(currentDepthFunc, func))
+			glDepthFunc(func);
+	}
+
+	void GLStateCache::depthMask(GLboolean flag)
+	{
+		if (change(currentDepthMask, (int8_t)(flag ? 1 : 0)))
+			glDepthMask(flag);
+	}
+
+	void GLStateCache::cullFace(GLenum mode)
+	{
+		if (change(currentCullFace, mode))
+			glCullFace(mode);
+	}
+
+	void GLStateCache::frontFace(GLenum mode)
+	{
+		if (change(currentFrontFace, mode))
+			glFrontFace(mode);
+	}
+
+	void GLStateCache::colorMask(GLboolean r, GLboolean g, GLboolean b, GLboolean a)
+	{
+		std::array<int8_t, 4> mask = { (int8_t)(r ? 1 : 0), (int8_t)(g ? 1 : 0), (int8_t)(b ? 1 : 0), (int8_t)(a ? 1 : 0) };
+		if (change(currentColorMask, mask))
+			glColorMask(r, g, b, a);
+	}
+
+	void GLStateCache::viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+	{
+		if (change(currentViewport, { x, y, width, height }))
+			glViewport(x, y, width, height);
+	}
+
+	void GLStateCache::scissor(GLint x, GLint y, GLsizei width, GLsizei height)
+	{
+		if (change(currentScissor, { x, y, width, height }))
+			glScissor(x, y, width, height);
+	}
+
+	void GLStateCache::clearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a)
+	{
+		if (change(currentClearColor, { r, g, b, a }))
+			glClearColor(r, g, b, a);
+	}
+
+	void GLStateCache::deleteProgram(GLuint program)
+	{
+		/* Unlike other objects, a program in use is only flagged for deletion and stays current,
+		   so currentProgram still matches GL. */
+		stats.issued++;
+		glDeleteProgram(program);
+	}
+
+	void GLStateCache::deleteVertexArray(GLuint vertexArray)
+	{
+		stats.issued++;
+		glDeleteVertexArrays(1, &vertexArray);
+		if (currentVertexArray == vertexArray)
+		{
+			currentVertexArray = 0;
+			currentBuffers[ELEMENT_ARRAY] = UNKNOWN;
+		}
+	}
+
+	void GLStateCache::deleteBuffer(GLuint buffer)
+	{
+		stats.issued++;
+		glDeleteBuffers(1, &buffer);
+		for (GLuint& bound : currentBuffers)
+			if (bound == buffer)
+				bound = 0;
+	}
+
+	void GLStateCache::deleteFramebuffer(GLuint framebuffer)
+	{
+		stats.issued++;
+		glDeleteFramebuffers(1, &framebuffer);
+		if (currentDrawFramebuffer == framebuffer)
+			currentDrawFramebuffer = 0;
+		if (currentReadFramebuffer == framebuffer)
+			currentReadFramebuffer = 0;
+	}
+
+	void GLStateCache::deleteTexture(GLuint texture)
+	{
+		stats.issued++;
+		glDeleteTextures(1, &texture);
+		for (auto& unit : currentTextures)
+			for (GLuint& bound : unit)
+				if (bound == texture)
+					bound = 0;
+
+		/* Unknown rather than 0, since the unit may still hold a texture on another target. */
+		for (GLuint& bound : currentUnitTextures)
+			if (bound == texture)
+				bound = UNKNOWN;
+	}
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "LeadEngine/core.h"
+
+#include "glad/glad.h"
+
+namespace le
+{
+	struct GLStateStats
+	{
+		uint64_t issued = 0;
+		uint64_t elided = 0;
+	};
+
+	/* Shadows the bindings and fixed function state of one GL context and skips calls that
+	   would not change anything. All state starts unknown, so the first call of each kind is
+	   always issued. Calls go through the Glad function pointers, so FakeGL::load() lets this
+	   run without a GPU.
+
+	   Anything that changes GL state behind the cache's back must be followed by invalidate(). */
+	class LE_API GLStateCache
+	{
+	public:
+		static constexpr unsigned int MAX_TEXTURE_UNITS = 32;
+	private:
+		static constexpr GLuint UNKNOWN = 0xFFFFFFFF;
+
+		enum BufferSlot { ARRAY, ELEMENT_ARRAY, UNIFORM, SHADER_STORAGE, COPY_READ, COPY_WRITE, PIXEL_PACK, PIXEL_UNPACK, DRAW_INDIRECT, DISPATCH_INDIRECT, BUFFER_SLOT_COUNT };
+		enum TextureSlot { TEX_2D, TEX_2D_ARRAY, TEX_3D, TEX_CUBE_MAP, TEXTURE_SLOT_COUNT };
+		enum Capability { BLEND, DEPTH_TEST, CULL_FACE, SCISSOR_TEST, STENCIL_TEST, FRAMEBUFFER_SRGB, MULTISAMPLE, CAPABILITY_COUNT };
+
+		static int bufferSlot(GLenum target);
+		static int textureSlot(GLenum target);
+		static int capability(GLenum cap);
+
+		/* Records the call as issued or elided. Returns true if it must be issued. */
+		template<typename T>
+		inline bool change(T& shadow, const T& value)
+		{
+			if (shadow == value)
+			{
+				stats.elided++;
+				return false;
+			}
+			shadow = value;
+			stats.issued++;
+			return true;
+		}
+
+		GLuint currentProgram;
+		GLuint currentVertexArray;
+		GLuint currentDrawFramebuffer, currentReadFramebuffer;
+		std::array<GLuint, BUFFER_SLOT_COUNT> currentBuffers;
+
+		GLenum currentUnit;
+		std::array<std::array<GLuint, TEXTURE_SLOT_COUNT>, MAX_TEXTURE_UNITS> currentTextures;
+		/* Set by glBindTextureUnit, which does not say which target it bound. */
+		std::array<GLuint, MAX_TEXTURE_UNITS> currentUnitTextures;
+
+		std::array<int8_t, CAPABILITY_COUNT> currentCapabilities;
+		std::array<GLenum, 4> currentBlendFunc;
+		std::array<GLenum, 2> currentBlendEquation;
+		GLenum currentDepthFunc;
+		int8_t currentDepthMask;
+		GLenum currentCullFace;
+		GLenum currentFrontFace;
+		std::array<int8_t, 4> currentColorMask;
+		std::array<GLint, 4> currentViewport;
+		std::array<GLint, 4> currentScissor;
+		std::array<GLfloat, 4> currentClearColor;
+
+		GLStateStats stats;
+	public:
+		GLStateCache();
+
+		/* Forgets all shadowed state. */
+		void invalidate();
+
+		void useProgram(GLuint program);
+		void bindVertexArray(GLuint vertexArray);
+		void bindBuffer(GLenum target, GLuint buffer);
+		void bindFramebuffer(GLenum target, GLuint framebuffer);
+
+		/* unit is the GL_TEXTURE0 based enum, as for glActiveTexture. */
+		void activeTexture(GLenum unit);
+		void bindTexture(GLenum target, GLuint texture);
+		/* unit is the zero based index, as for glBindTextureUnit. */
+		void bindTextureUnit(GLuint unit, GLuint texture);
+
+		void enable(GLenum cap);
+		void disable(GLenum cap);
+		void setEnabled(GLenum cap, bool enabled);
+
+		void blendFunc(GLenum src, GLenum dst);
+		void blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha);
+		void blendEquation(GLenum mode);
+		void blendEquationSeparate(GLenum modeRGB, GLenum modeAlpha);
+		void depthFunc(GLenum func);
+		void depthMask(GLboolean flag);
+		void cullFace(GLenum mode);
+		void frontFace(GLenum mode);
+		void colorMask(GLboolean r, GLboolean g, GLboolean b, GLboolean a);
+		void viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+		void scissor(GLint x, GLint y, GLsizei width, GLsizei height);
+		void clearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a);
+
+		/* Deleting a bound object unbinds it in GL, so these keep the shadow in step. */
+		void deleteProgram(GLuint program);
+		void deleteVertexArray(GLuint vertexArray);
+		void deleteBuffer(GLuint buffer);
+		void deleteFramebuffer(GLuint framebuffer);
+		void deleteTexture(GLuint texture);
+
+		inline const GLStateStats& getStats() const { return stats; }
+		inline void resetStats() { stats = GLStateStats(); }
+	};
+}
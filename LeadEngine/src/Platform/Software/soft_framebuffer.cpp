@@ -0,0 +1,122 @@
+#include "le_pch.h"
+
+#include "soft_framebuffer.h"
+
+#include <fstream>
+
+namespace le
+{
+	SoftFramebuffer::SoftFramebuffer(unsigned int width, unsigned int height)
+	{
+		resize(width, height);
+	}
+
+	void SoftFramebuffer::resize(unsigned int width, unsigned int height)
+	{
+		this->width = width;
+		this->height = height;
+		stride = (width + 3) & ~3u;
+
+		color.assign((size_t)stride * height, 0);
+		depth.assign((size_t)stride * height, 1.0f);
+	}
+
+	void SoftFramebuffer::clear(uint32_t clearColor, float clearDepth)
+	{
+		std::fill(color.begin(), color.end(), clearColor);
+		std::fill(depth.begin(), depth.end(), clearDepth);
+	}
+
+	bool SoftFramebuffer::writePPM(const std::string& path) const
+	{
+		std::ofstream file(path, std::ios::binary);
+		if (!file)
+		{
+			LE_CORE_ERROR("Could not open {0} for writing!", path);
+			return false;
+		}
+
+		file << "P6\n" << width << " " << height << "\n255\n";
+
+		std::vector<uint8_t> row(width * 3);
+		for (unsigned int y = 0; y < height; y++)
+		{
+			const uint32_t* src = &color[(size_t)y * stride];
+			for (unsigned int x = 0; x < width; x++)
+			{
+				row[x * 3 + 0] = (uint8_t)(src[x]);
+				row[x * 3 + 1] = (uint8_t)(src[x] >> 8);
+				row[x * 3 + 2] = (uint8_t)(src[x] >> 16);
+			}
+			file.write((const char*)row.data(), row.size());
+		}
+
+		return (bool)file;
+	}
+
+	bool SoftFramebuffer::readPPM(const std::string& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file)
+		{
+			LE_CORE_ERROR("Could not open {0} for reading!", path);
+			return false;
+		}
+
+		std::string magic;
+		unsigned int fileWidth = 0, fileHeight = 0, maxValue = 0;
+		file >> magic >> fileWidth >> fileHeight >> maxValue;
+		file.get();
+
+		if (!file || magic != "P6" || maxValue != 255 || fileWidth == 0 || fileHeight == 0 || fileWidth > 16384 || fileHeight > 16384)
+		{
+			LE_CORE_ERROR("{0} is not an 8-bit binary PPM!", path);
+			return false;
+		}
+
+		resize(fileWidth, fileHeight);
+
+		std::vector<uint8_t> row(width * 3);
+		for (unsigned int y = 0; y < height; y++)
+		{
+			if (!file.read((char*)row.data(), row.size()))
+			{
+				LE_CORE_ERROR("{0} is truncated!", path);
+				return false;
+			}
+
+			uint32_t* dst = &color[(size_t)y * stride];
+			for (unsigned int x = 0; x < width; x++)
+				dst[x] = packColor(row[x * 3 + 0], row[x * 3 + 1], row[x * 3 + 2], 255);
+		}
+
+		return true;
+	}
+
+	size_t SoftFramebuffer::countDifferentPixels(const SoftFramebuffer& other, uint8_t tolerance) const
+	{
+		if (width != other.width || height != other.height)
+			return (size_t)width * height;
+
+		size_t different = 0;
+		for (unsigned int y = 0; y < height; y++)
+		{
+			const uint32_t* a = &color[(size_t)y * stride];
+			const uint32_t* b = &other.color[(size_t)y * other.stride];
+			for (unsigned int x = 0; x < width; x++)
+			{
+				for (int shift = 0; shift < 24; shift += 8)
+				{
+					int delta = (int)((a[x] >> shift) & 0xFF) - (int)((b[x] >> shift) & 0xFF);
+					if (delta > tolerance || -delta > tolerance)
+					{
+						different++;
+						break;
+					}
+				}
+			}
+		}
+
+		return different;
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+
+#include "LeadEngine/core.h"
+
+namespace le
+{
+	/* In-memory RGBA8 colour buffer with a float depth buffer. Rows are padded to a multiple of
+	   4 pixels so the rasterizer can always load and store 4 pixels at once. */
+	class LE_API SoftFramebuffer
+	{
+	private:
+		unsigned int width, height, stride;
+		std::vector<uint32_t> color;
+		std::vector<float> depth;
+	public:
+		SoftFramebuffer(unsigned int width, unsigned int height);
+
+		void resize(unsigned int width, unsigned int height);
+		void clear(uint32_t clearColor = packColor(0, 0, 0, 255), float clearDepth = 1.0f);
+
+		/* Writes the colour buffer as a binary PPM (alpha is dropped). */
+		bool writePPM(const std::string& path) const;
+
+		/* Resizes to and loads a binary PPM as written by writePPM, alpha set to 255. Depth is cleared. */
+		bool readPPM(const std::string& path);
+
+		/* Pixels whose red, green or blue differ from other by more than tolerance, alpha is
+		   ignored. Every pixel counts as different if the sizes do not match. */
+		size_t countDifferentPixels(const SoftFramebuffer& other, uint8_t tolerance = 0) const;
+
+		inline unsigned int getWidth() const { return width; }
+		inline unsigned int getHeight() const { return height; }
+		inline unsigned int getStride() const { return stride; }
+
+		inline uint32_t* getColorData() { return color.data(); }
+		inline const uint32_t* getColorData() const { return color.data(); }
+		inline float* getDepthData() { return depth.data(); }
+		inline const float* getDepthData() const { return depth.data(); }
+
+		inline uint32_t getPixel(unsigned int x, unsigned int y) const { return color[y * stride + x]; }
+		inline float getDepth(unsigned int x, unsigned int y) const { return depth[y * stride + x]; }
+
+		static constexpr uint32_t packColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+		{
+			return (uint32_t)r | ((uint32_t)g << 8) | ((uint32_t)b << 16) | ((uint32_t)a << 24);
+		}
+	};
+}
@@ -0,0 +1,246 @@
+#include "le_pch.h"
+
+#include "soft_rasterizer.h"
+
+#include "LeadEngine/thread_pool.h"
+
+#include <cmath>
+#include <emmintrin.h>
+
+namespace le
+{
+	/* Triangles per setup/binning chunk. */
+	static const size_t TRIANGLES_PER_CHUNK = 256;
+
+	SoftRasterizer::SoftRasterizer()
+	{
+	}
+
+	bool SoftRasterizer::setupTriangle(const SoftVertex& v0, const SoftVertex& v1, const SoftVertex& v2, TriangleSetup& setup) const
+	{
+		const SoftVertex* v[3] = { &v0, &v1, &v2 };
+
+		/* No clipping, so anything touching the near plane or behind the eye is dropped. */
+		for (int i = 0; i < 3; i++)
+			if (v[i]->w <= 1e-5f || v[i]->z < -v[i]->w)
+				return false;
+
+		float halfW = target->getWidth() * 0.5f;
+		float halfH = target->getHeight() * 0.5f;
+
+		float sx[3], sy[3];
+		for (int i = 0; i < 3; i++)
+		{
+			float invW = 1.0f / v[i]->w;
+			sx[i] = (v[i]->x * invW + 1.0f) * halfW;
+			sy[i] = (1.0f - v[i]->y * invW) * halfH;
+			setup.z[i] = v[i]->z * invW * 0.5f + 0.5f;
+			setup.invW[i] = invW;
+			setup.color[i][0] = v[i]->r * invW;
+			setup.color[i][1] = v[i]->g * invW;
+			setup.color[i][2] = v[i]->b * invW;
+			setup.color[i][3] = v[i]->a * invW;
+		}
+
+		/* Screen y points down, so counter-clockwise triangles have negative area here. */
+		float area = (sx[1] - sx[0]) * (sy[2] - sy[0]) - (sy[1] - sy[0]) * (sx[2] - sx[0]);
+		if (area == 0.0f || (cullBackFaces && area > 0.0f))
+			return false;
+
+		float sign = area < 0.0f ? 1.0f : -1.0f;
+		setup.invArea = 1.0f / (area * -sign);
+
+		/* Edge i is opposite vertex i, so its value is the unnormalised barycentric weight of vertex i. */
+		for (int i = 0; i < 3; i++)
+		{
+			int a = (i + 1) % 3;
+			int b = (i + 2) % 3;
+
+			setup.edgeA[i] = (sy[b] - sy[a]) * sign;
+			setup.edgeB[i] = (sx[a] - sx[b]) * sign;
+			setup.edgeC[i] = (sx[b] * sy[a] - sx[a] * sy[b]) * sign;
+
+			/* Top-left fill rule: pixels exactly on a top or left edge belong to this triangle. */
+			setup.topLeft[i] = setup.edgeA[i] > 0.0f || (setup.edgeA[i] == 0.0f && setup.edgeB[i] > 0.0f);
+		}
+
+		/* Reject fully off-screen triangles, then clamp both ends in float so far off-screen
+		   vertices cannot overflow the int conversion or produce negative tile indices. */
+		float maxX = (float)target->getWidth() - 1.0f;
+		float maxY = (float)target->getHeight() - 1.0f;
+		float boundsMinX = std::min({ sx[0], sx[1], sx[2] });
+		float boundsMinY = std::min({ sy[0], sy[1], sy[2] });
+		float boundsMaxX = std::max({ sx[0], sx[1], sx[2] });
+		float boundsMaxY = std::max({ sy[0], sy[1], sy[2] });
+		if (!(boundsMaxX >= 0.0f && boundsMaxY >= 0.0f && boundsMinX <= maxX && boundsMinY <= maxY))
+			return false;
+
+		setup.minX = (int)std::floor(std::clamp(boundsMinX, 0.0f, maxX));
+		setup.minY = (int)std::floor(std::clamp(boundsMinY, 0.0f, maxY));
+		setup.maxX = (int)std::ceil(std::clamp(boundsMaxX, 0.0f, maxX));
+		setup.maxY = (int)std::ceil(std::clamp(boundsMaxY, 0.0f, maxY));
+
+		return setup.minX <= setup.maxX && setup.minY <= setup.maxY;
+	}
+
+	void SoftRasterizer::draw(SoftFramebuffer& target, const SoftVertex* vertices, const uint32_t* indices, size_t indexCount)
+	{
+		this->target = &target;
+		tilesX = (target.getWidth() + TILE_SIZE - 1) / TILE_SIZE;
+		tilesY = (target.getHeight() + TILE_SIZE - 1) / TILE_SIZE;
+		size_t tileCount = (size_t)tilesX * tilesY;
+
+		size_t triangleCount = indexCount / 3;
+		chunkCount = (triangleCount + TRIANGLES_PER_CHUNK - 1) / TRIANGLES_PER_CHUNK;
+
+		setups.resize(triangleCount);
+		std::vector<size_t> accepted(chunkCount, 0);
+		bins.resize(chunkCount * tileCount);
+		for (auto& bin : bins)
+			bin.clear();
+
+		ThreadPool& pool = ThreadPool::get();
+
+		pool.parallelFor(chunkCount, [&](size_t begin, size_t end)
+			{
+				for (size_t chunk = begin; chunk < end; chunk++)
+				{
+					std::vector<uint32_t>* chunkBins = &bins[chunk * tileCount];
+					size_t last = std::min((chunk + 1) * TRIANGLES_PER_CHUNK, triangleCount);
+
+					for (size_t t = chunk * TRIANGLES_PER_CHUNK; t < last; t++)
+					{
+						TriangleSetup& setup = setups[t];
+						if (!setupTriangle(vertices[indices[t * 3]], vertices[indices[t * 3 + 1]], vertices[indices[t * 3 + 2]], setup))
+							continue;
+
+						accepted[chunk]++;
+						for (int ty = setup.minY / TILE_SIZE; ty <= setup.maxY / (int)TILE_SIZE; ty++)
+							for (int tx = setup.minX / TILE_SIZE; tx <= setup.maxX / (int)TILE_SIZE; tx++)
+								chunkBins[ty * tilesX + tx].push_back((uint32_t)t);
+					}
+				}
+			});
+
+		pool.parallelFor(tileCount, [&](size_t begin, size_t end)
+			{
+				for (size_t tile = begin; tile < end; tile++)
+					rasterizeTile((unsigned int)tile);
+			});
+
+		stats.trianglesSubmitted += triangleCount;
+		for (size_t count : accepted)
+			stats.trianglesRasterized += count;
+		for (const auto& bin : bins)
+			stats.binEntries += bin.size();
+	}
+
+	void SoftRasterizer::rasterizeTile(unsigned int tile)
+	{
+		size_t tileCount = (size_t)tilesX * tilesY;
+		int tileX = (int)(tile % tilesX) * TILE_SIZE;
+		int tileY = (int)(tile / tilesX) * TILE_SIZE;
+		int tileMaxX = std::min(tileX + (int)TILE_SIZE, (int)target->getWidth()) - 1;
+		int tileMaxY = std::min(tileY + (int)TILE_SIZE, (int)target->getHeight()) - 1;
+
+		unsigned int stride = target->getStride();
+		uint32_t* colorBuffer = target->getColorData();
+		float* depthBuffer = target->getDepthData();
+
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 laneOffset = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+		const __m128 scale = _mm_set1_ps(255.0f);
+		const __m128i lanes = _mm_set_epi32(3, 2, 1, 0);
+
+		for (size_t chunk = 0; chunk < chunkCount; chunk++)
+		{
+			for (uint32_t t : bins[chunk * tileCount + tile])
+			{
+				const TriangleSetup& s = setups[t];
+
+				int x0 = std::max(s.minX, tileX) & ~3;
+				int x1 = std::min(s.maxX, tileMaxX);
+				int y0 = std::max(s.minY, tileY);
+				int y1 = std::min(s.maxY, tileMaxY);
+
+				__m128 edgeStep[3], topLeft[3];
+				for (int e = 0; e < 3; e++)
+				{
+					edgeStep[e] = _mm_set1_ps(s.edgeA[e] * 4.0f);
+					topLeft[e] = _mm_castsi128_ps(_mm_set1_epi32(s.topLeft[e] ? -1 : 0));
+				}
+
+				__m128 invArea = _mm_set1_ps(s.invArea);
+				__m128 z[3], invW[3], col[3][4];
+				for (int v = 0; v < 3; v++)
+				{
+					z[v] = _mm_set1_ps(s.z[v]);
+					invW[v] = _mm_set1_ps(s.invW[v]);
+					for (int c = 0; c < 4; c++)
+						col[v][c] = _mm_set1_ps(s.color[v][c]);
+				}
+
+				__m128i xLimit = _mm_set1_epi32(x1 + 1);
+
+				for (int y = y0; y <= y1; y++)
+				{
+					__m128 px = _mm_add_ps(_mm_set1_ps((float)x0), laneOffset);
+					__m128 py = _mm_set1_ps(y + 0.5f);
+
+					__m128 edge[3];
+					for (int e = 0; e < 3; e++)
+						edge[e] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(s.edgeA[e]), px), _mm_mul_ps(_mm_set1_ps(s.edgeB[e]), py)), _mm_set1_ps(s.edgeC[e]));
+
+					size_t row = (size_t)y * stride;
+
+					for (int x = x0; x <= x1; x += 4)
+					{
+						__m128 inside = _mm_castsi128_ps(_mm_cmplt_epi32(_mm_add_epi32(_mm_set1_epi32(x), lanes), xLimit));
+						for (int e = 0; e < 3; e++)
+						{
+							__m128 covered = _mm_or_ps(_mm_cmpgt_ps(edge[e], zero), _mm_and_ps(_mm_cmpeq_ps(edge[e], zero), topLeft[e]));
+							inside = _mm_and_ps(inside, covered);
+						}
+
+						if (_mm_movemask_ps(inside))
+						{
+							__m128 b0 = _mm_mul_ps(edge[0], invArea);
+							__m128 b1 = _mm_mul_ps(edge[1], invArea);
+							__m128 b2 = _mm_mul_ps(edge[2], invArea);
+
+							__m128 depth = _mm_add_ps(_mm_add_ps(_mm_mul_ps(b0, z[0]), _mm_mul_ps(b1, z[1])), _mm_mul_ps(b2, z[2]));
+							float* depthPtr = depthBuffer + row + x;
+							__m128 oldDepth = _mm_loadu_ps(depthPtr);
+
+							if (depthTest)
+								inside = _mm_and_ps(inside, _mm_cmplt_ps(depth, oldDepth));
+
+							if (_mm_movemask_ps(inside))
+							{
+								_mm_storeu_ps(depthPtr, _mm_or_ps(_mm_and_ps(inside, depth), _mm_andnot_ps(inside, oldDepth)));
+
+								__m128 w = _mm_div_ps(_mm_set1_ps(1.0f), _mm_add_ps(_mm_add_ps(_mm_mul_ps(b0, invW[0]), _mm_mul_ps(b1, invW[1])), _mm_mul_ps(b2, invW[2])));
+
+								__m128i packed = _mm_setzero_si128();
+								for (int c = 0; c < 4; c++)
+								{
+									__m128 value = _mm_add_ps(_mm_add_ps(_mm_mul_ps(b0, col[0][c]), _mm_mul_ps(b1, col[1][c])), _mm_mul_ps(b2, col[2][c]));
+									value = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_mul_ps(value, w), scale), zero), scale);
+									packed = _mm_or_si128(packed, _mm_slli_epi32(_mm_cvtps_epi32(value), c * 8));
+								}
+
+								__m128i* colorPtr = (__m128i*)(colorBuffer + row + x);
+								__m128i mask = _mm_castps_si128(inside);
+								__m128i oldColor = _mm_loadu_si128(colorPtr);
+								_mm_storeu_si128(colorPtr, _mm_or_si128(_mm_and_si128(mask, packed), _mm_andnot_si128(mask, oldColor)));
+							}
+						}
+
+						for (int e = 0; e < 3; e++)
+							edge[e] = _mm_add_ps(edge[e], edgeStep[e]);
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+
+#include "LeadEngine/core.h"
+#include "soft_framebuffer.h"
+
+namespace le
+{
+	/* Clip space position and colour. Colour is interpolated perspective correctly. */
+	struct SoftVertex
+	{
+		float x, y, z, w;
+		float r, g, b, a;
+	};
+
+	struct SoftRasterizerStats
+	{
+		size_t trianglesSubmitted = 0;
+		size_t trianglesRasterized = 0;
+		size_t binEntries = 0;
+	};
+
+	/* Tiled CPU rasterizer. Triangles are set up and binned into screen tiles in parallel,
+	   then each tile is rasterized by one worker 4 pixels at a time, so no two threads ever
+	   touch the same pixel. Triangles within a tile are drawn in submission order. */
+	class LE_API SoftRasterizer
+	{
+	public:
+		static constexpr unsigned int TILE_SIZE = 64;
+	private:
+		struct TriangleSetup
+		{
+			/* Edge function e(x, y) = a * x + b * y + c, normalised so the interior is positive. */
+			float edgeA[3], edgeB[3], edgeC[3];
+			bool topLeft[3];
+			float invArea;
+			float z[3];
+			float invW[3];
+			/* Colour premultiplied by 1/w for perspective correct interpolation. */
+			float color[3][4];
+			int minX, minY, maxX, maxY;
+		};
+
+		bool setupTriangle(const SoftVertex& v0, const SoftVertex& v1, const SoftVertex& v2, TriangleSetup& setup) const;
+		void rasterizeTile(unsigned int tile);
+
+		SoftFramebuffer* target = nullptr;
+		unsigned int tilesX = 0, tilesY = 0;
+		bool cullBackFaces = true;
+		bool depthTest = true;
+
+		std::vector<TriangleSetup> setups;
+		/* bins[chunk * tileCount + tile] holds indices into setups, chunks cover triangles in order. */
+		std::vector<std::vector<uint32_t>> bins;
+		size_t chunkCount = 0;
+
+		SoftRasterizerStats stats;
+	public:
+		SoftRasterizer();
+
+		/* Triangles are counter-clockwise when front facing, as in OpenGL. */
+		void draw(SoftFramebuffer& target, const SoftVertex* vertices, const uint32_t* indices, size_t indexCount);
+
+		inline void setCullBackFaces(bool enabled) { cullBackFaces = enabled; }
+		inline void setDepthTest(bool enabled) { depthTest = enabled; }
+
+		inline const SoftRasterizerStats& getStats() const { return stats; }
+		inline void resetStats() { stats = SoftRasterizerStats(); }
+	};
+}
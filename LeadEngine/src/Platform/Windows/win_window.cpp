@@ -15,11 +15,6 @@ namespace le
 		LE_CORE_ERROR("GLFW Error ({0}): {1}", error, description);
 	}
 
-	Window* Window::create(const WindowData& properties)
-	{
-		return new WinWindow(properties);
-	}
-
 	WinWindow::WinWindow(const WindowData& properties)
 	{
 		init(properties);
@@ -153,6 +148,7 @@ namespace le
 	void WinWindow::update()
 	{
 		glfwSwapBuffers(window);
+		presentTime = EventClock::now();
 		glfwPollEvents();
 	}
 
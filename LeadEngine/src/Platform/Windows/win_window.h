@@ -1,6 +1,6 @@
 #pragma once
 
-#include "LeadEngine/Window.h"
+#include "LeadEngine/window.h"
 
 #include <GLFW/glfw3.h>
 
@@ -13,6 +13,7 @@ namespace le
 		virtual void close();
 
 		GLFWwindow* window;
+		EventClock::time_point presentTime;
 
 		struct WinWindowData
 		{
@@ -32,6 +33,7 @@ namespace le
 
 		inline unsigned int getWidth() const override { return data.width; }
 		inline unsigned int getHeight() const override { return data.height; }
+		inline EventClock::time_point getPresentTime() const override { return presentTime; }
 
 		/* Window attributes. */
 		inline void setEventCallback(const EventCallbackFn& callback) override { data.eventCallback = callback; }
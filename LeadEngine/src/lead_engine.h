@@ -4,6 +4,14 @@
 #include "LeadEngine/app.h"
 #include "LeadEngine/layer.h"
 #include "LeadEngine/log.h"
+#include "LeadEngine/thread_pool.h"
+#include "LeadEngine/Particles/particle_system.h"
+#include "LeadEngine/Scene/transform_hierarchy.h"
+#include "LeadEngine/Net/replication.h"
+#include "LeadEngine/Net/loopback_transport.h"
+#include "LeadEngine/Animation/animation_system.h"
+#include "LeadEngine/Text/text_renderer.h"
+#include "Platform/Software/soft_rasterizer.h"
 
 /* ENTRY POINT ----------------------- */
 #include "LeadEngine/entry_point.h"
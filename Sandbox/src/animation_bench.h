@@ -0,0 +1,85 @@
+#pragma once
+
+#include <lead_engine.h>
+
+#include <chrono>
+#include <cmath>
+
+/* Animates a crowd of characters blending two procedural clips each frame and logs how many
+   characters fit in a 60 Hz frame. Runs without a GPU. */
+class AnimationBenchLayer : public le::Layer
+{
+private:
+	static constexpr size_t JOINT_COUNT = 64;
+	static constexpr size_t FRAME_COUNT = 60;
+
+	le::Skeleton skeleton;
+	std::unique_ptr<le::AnimationClip> walk, wave;
+	le::AnimationSystem animation;
+	double updateMs = 0.0;
+	int frames = 0;
+
+	std::unique_ptr<le::AnimationClip> makeClip(float frequency)
+	{
+		std::vector<le::LocalTransform> keys(JOINT_COUNT * FRAME_COUNT);
+		for (size_t f = 0; f < FRAME_COUNT; f++)
+		{
+			for (size_t j = 0; j < JOINT_COUNT; j++)
+			{
+				float angle = std::sin(f * frequency + j * 0.3f) * 0.5f;
+				le::LocalTransform& key = keys[f * JOINT_COUNT + j];
+				key.position[1] = 0.1f;
+				key.rotation[2] = std::sin(angle * 0.5f);
+				key.rotation[3] = std::cos(angle * 0.5f);
+			}
+		}
+		return std::make_unique<le::AnimationClip>(JOINT_COUNT, FRAME_COUNT, 30.0f, keys.data());
+	}
+public:
+	AnimationBenchLayer(size_t characterCount = 1000) : Layer("AnimationBench")
+	{
+		for (size_t j = 0; j < JOINT_COUNT; j++)
+		{
+			/* Four limbs hanging off the root. */
+			skeleton.parents.push_back(j == 0 ? le::Skeleton::NO_PARENT : (j <= 4 ? 0 : (int32_t)j - 4));
+			skeleton.inverseBindPose.push_back(le::Mat4::identity());
+			skeleton.names.push_back("joint" + std::to_string(j));
+		}
+
+		walk = makeClip(0.2f);
+		wave = makeClip(0.35f);
+
+		for (size_t i = 0; i < characterCount; i++)
+		{
+			le::AnimatedCharacter* character = animation.get(animation.addCharacter(skeleton));
+
+			le::AnimationLayer walkLayer, waveLayer;
+			walkLayer.clip = walk.get();
+			walkLayer.time = i * 0.01f;
+			walkLayer.weight = 0.7f;
+			waveLayer.clip = wave.get();
+			waveLayer.weight = 0.3f;
+
+			character->addLayer(walkLayer);
+			character->addLayer(waveLayer);
+		}
+	}
+
+	void update() override
+	{
+		auto start = std::chrono::steady_clock::now();
+		animation.update(1.0f / 60.0f);
+		auto end = std::chrono::steady_clock::now();
+
+		updateMs += std::chrono::duration<double, std::milli>(end - start).count();
+
+		if (++frames == 120)
+		{
+			double msPerFrame = updateMs / frames;
+			LE_INFO("AnimationBench: {0} characters in {1:.3f} ms, ~{2:.0f} characters per 16.6 ms frame",
+				animation.getCharacterCount(), msPerFrame, animation.getCharacterCount() * 16.6 / msPerFrame);
+			updateMs = 0.0;
+			frames = 0;
+		}
+	}
+};
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <lead_engine.h>
+
+#include <cmath>
+#include <cstring>
+
+#include "check_layer.h"
+
+/* Checks the animation pipeline a piece at a time against values worked out by hand. Clip keys
+   must decode to within one quantization step, blended poses must be the weighted average
+   with nlerped rotations along the shortest path, a character whose only layer drops to zero
+   weight must hold its last pose, and a vertex skinned by two joints must land where the
+   weighted matrices put it. */
+class AnimationCheckLayer : public CheckLayer
+{
+private:
+	/* Not a multiple of 4, so the padding joints are covered too. */
+	static constexpr size_t JOINT_COUNT = 5;
+	static constexpr size_t FRAME_COUNT = 7;
+	static constexpr float SAMPLE_RATE = 10.0f;
+	/* Float rounding on top of the quantization error. */
+	static constexpr float EPSILON = 1e-5f;
+
+	le::Skeleton skeleton;
+	std::vector<le::LocalTransform> keys;
+	std::unique_ptr<le::AnimationClip> clip;
+
+	static inline bool near(float a, float b, float tolerance = EPSILON) { return std::fabs(a - b) <= tolerance; }
+
+	static float getComponent(const le::LocalTransform& t, int c)
+	{
+		if (c <= le::Pose::TZ)
+			return t.position[c - le::Pose::TX];
+		if (c <= le::Pose::RW)
+			return t.rotation[c - le::Pose::RX];
+		return t.scale[c - le::Pose::SX];
+	}
+
+	/* One joint at (x, y, 0), turned about z by the quaternion (0, 0, qz, qw). */
+	static le::Pose makePose(float x, float y, float qz, float qw)
+	{
+		le::Pose pose;
+		pose.resize(1);
+		pose.get(le::Pose::TX)[0] = x;
+		pose.get(le::Pose::TY)[0] = y;
+		pose.get(le::Pose::RZ)[0] = qz;
+		pose.get(le::Pose::RW)[0] = qw;
+		return pose;
+	}
+
+	bool checkQuantization()
+	{
+		le::Pose pose;
+		for (size_t f = 0; f < FRAME_COUNT; f++)
+		{
+			clip->sample((float)f / SAMPLE_RATE, pose);
+
+			for (int c = 0; c < le::Pose::COMPONENT_COUNT; c++)
+			{
+				for (size_t j = 0; j < JOINT_COUNT; j++)
+				{
+					/* The clip quantizes each joint and component over its own range. */
+					float lo = getComponent(keys[j], c), hi = lo;
+					for (size_t k = 1; k < FRAME_COUNT; k++)
+					{
+						lo = std::min(lo, getComponent(keys[k * JOINT_COUNT + j], c));
+						hi = std::max(hi, getComponent(keys[k * JOINT_COUNT + j], c));
+					}
+
+					float step = (hi - lo) / 65535.0f;
+					float expected = getComponent(keys[f * JOINT_COUNT + j], c);
+					float actual = pose.get((le::Pose::Component)c)[j];
+					if (!near(actual, expected, step + EPSILON))
+					{
+						LE_ERROR("AnimationCheck: component {0} of joint {1} in frame {2} decodes to {3}, expected {4} within {5}", c, j, f, actual, expected, step);
+						return false;
+					}
+				}
+			}
+		}
+
+		/* Padding joints decode to the identity. */
+		return expect(pose.get(le::Pose::TX)[JOINT_COUNT] == 0.0f && pose.get(le::Pose::RW)[JOINT_COUNT] == 1.0f && pose.get(le::Pose::SX)[JOINT_COUNT] == 1.0f,
+			"padding joint is not the identity");
+	}
+
+	bool checkBlend()
+	{
+		const float h = std::sqrt(0.5f);
+		le::Pose poses[2] = { makePose(2.0f, 0.0f, 0.0f, 1.0f), makePose(0.0f, 4.0f, h, h) };
+		float weights[2] = { 0.25f, 0.75f };
+
+		/* Translation 0.25 * (2, 0, 0) + 0.75 * (0, 4, 0), rotation 0.25 * (0, 0, 0, 1) + 0.75 * (0, 0, h, h) renormalised. */
+		float z = 0.75f * h, w = 0.25f + 0.75f * h;
+		float length = std::sqrt(z * z + w * w);
+
+		le::Pose out;
+		bool passed = le::blendPoses(poses, weights, 2, out) && near(out.get(le::Pose::TX)[0], 0.5f) && near(out.get(le::Pose::TY)[0], 3.0f)
+			&& near(out.get(le::Pose::RX)[0], 0.0f) && near(out.get(le::Pose::RZ)[0], z / length) && near(out.get(le::Pose::RW)[0], w / length)
+			&& near(out.get(le::Pose::SX)[0], 1.0f);
+		if (!expect(passed, "blended pose is not the weighted average"))
+			return false;
+
+		/* The same rotation with the opposite sign must take the shortest path to the same result. */
+		poses[1] = makePose(0.0f, 4.0f, -h, -h);
+		le::Pose flipped;
+		passed = le::blendPoses(poses, weights, 2, flipped) && near(flipped.get(le::Pose::RZ)[0], z / length) && near(flipped.get(le::Pose::RW)[0], w / length);
+		if (!expect(passed, "blend took the long way round a negated quaternion"))
+			return false;
+
+		/* Poses of different sizes are rejected and leave out alone. */
+		std::vector<float> before = out.data;
+		poses[1].resize(JOINT_COUNT);
+		return expect(!le::blendPoses(poses, weights, 2, out) && !le::blendPoses(poses, weights, 0, out) && out.data == before, "mismatched blend was not rejected");
+	}
+
+	bool checkZeroWeightHold()
+	{
+		le::AnimationLayer layer;
+		layer.clip = clip.get();
+		layer.loop = false;
+
+		/* Before the first sample a character is in its bind pose. */
+		layer.weight = 0.0f;
+		le::AnimatedCharacter idle(skeleton);
+		idle.addLayer(layer);
+		idle.update(0.25f);
+		const le::Mat4 identity = le::Mat4::identity();
+		for (const le::Mat4& skin : idle.getSkinMatrices())
+			if (!expect(std::memcmp(&skin, &identity, sizeof(le::Mat4)) == 0, "unweighted character left the bind pose"))
+				return false;
+
+		le::AnimatedCharacter character(skeleton);
+		layer.weight = 1.0f;
+		if (!expect(character.addLayer(layer), "clip rejected by its own skeleton"))
+			return false;
+
+		le::AnimationClip other(JOINT_COUNT + 1, 1, SAMPLE_RATE, keys.data());
+		layer.clip = &other;
+		if (!expect(!character.addLayer(layer), "clip for another skeleton accepted"))
+			return false;
+
+		character.update(0.25f);
+		std::vector<le::Mat4> held = character.getSkinMatrices();
+		std::vector<float> heldPose = character.getPose().data;
+
+		character.getLayers()[0].weight = 0.0f;
+		character.update(0.25f);
+		return expect(std::memcmp(held.data(), character.getSkinMatrices().data(), held.size() * sizeof(le::Mat4)) == 0 && character.getPose().data == heldPose,
+			"character did not hold its pose at zero weight");
+	}
+
+	bool checkSkinning()
+	{
+		/* Joint 0 moves by (1, 2, 3), joint 1 turns a quarter about z, taking x to y. */
+		const float h = std::sqrt(0.5f);
+		const float translation[3] = { 1.0f, 2.0f, 3.0f }, origin[3] = { 0.0f, 0.0f, 0.0f }, unitScale[3] = { 1.0f, 1.0f, 1.0f };
+		const float noRotation[4] = { 0.0f, 0.0f, 0.0f, 1.0f }, quarterTurn[4] = { 0.0f, 0.0f, h, h };
+		le::Mat4 matrices[2] = { le::Mat4::fromTRS(translation, noRotation, unitScale), le::Mat4::fromTRS(origin, quarterTurn, unitScale) };
+
+		le::SkinnedVertex vertex = { { 1.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 0, 1, 0, 0 }, { 0.25f, 0.75f, 0.0f, 0.0f } };
+		le::SkinnedOutputVertex out;
+		le::skinVertices(matrices, &vertex, 1, &out);
+
+		/* Position 0.25 * (2, 2, 3) + 0.75 * (0, 1, 0). The normal ignores translation: 0.25 * (1, 0, 0) + 0.75 * (0, 1, 0). */
+		bool passed = near(out.position[0], 0.5f) && near(out.position[1], 1.25f) && near(out.position[2], 0.75f)
+			&& near(out.normal[0], 0.25f) && near(out.normal[1], 0.75f) && near(out.normal[2], 0.0f);
+		return expect(passed, "skinned vertex is not the weighted sum of its joints' transforms");
+	}
+
+	bool run() override
+	{
+		return checkQuantization() && checkBlend() && checkZeroWeightHold() && checkSkinning();
+	}
+public:
+	AnimationCheckLayer(le::App& app) : CheckLayer(app, "AnimationCheck"), keys(JOINT_COUNT * FRAME_COUNT)
+	{
+		for (size_t j = 0; j < JOINT_COUNT; j++)
+		{
+			skeleton.parents.push_back(j == 0 ? le::Skeleton::NO_PARENT : (int32_t)j - 1);
+			skeleton.inverseBindPose.push_back(le::Mat4::identity());
+			skeleton.names.push_back("joint" + std::to_string(j));
+		}
+
+		/* Ranges from none (z) to large (y), rotations about a tilted axis. */
+		for (size_t f = 0; f < FRAME_COUNT; f++)
+		{
+			for (size_t j = 0; j < JOINT_COUNT; j++)
+			{
+				le::LocalTransform& key = keys[f * JOINT_COUNT + j];
+				float half = (f * 0.35f + j * 0.2f) * 0.5f;
+
+				key.position[0] = std::sin(f * 0.9f + j) * 3.0f;
+				key.position[1] = f * 17.0f - j;
+				key.position[2] = 50.0f * j;
+				key.rotation[0] = std::sin(half) / 3.0f;
+				key.rotation[1] = std::sin(half) * 2.0f / 3.0f;
+				key.rotation[2] = std::sin(half) * 2.0f / 3.0f;
+				key.rotation[3] = std::cos(half);
+				key.scale[0] = 1.0f + 0.05f * f;
+			}
+		}
+
+		clip = std::make_unique<le::AnimationClip>(JOINT_COUNT, FRAME_COUNT, SAMPLE_RATE, keys.data());
+	}
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <lead_engine.h>
+
+/* Base of the headless --golden and --*-check layers. run() performs the whole check on the
+   first update, then the app closes with exit code 0 if it returned true and 1 otherwise.
+   Checks need no GPU, so they run headless. */
+class CheckLayer : public le::Layer
+{
+private:
+	le::App& app;
+protected:
+	CheckLayer(le::App& app, const std::string& name) : Layer(name), app(app)
+	{
+	}
+
+	/* Logs what, prefixed with the check's name, if condition is false. Returns condition. */
+	bool expect(bool condition, const char* what) const
+	{
+		if (!condition)
+			LE_ERROR("{0}: {1}", getName(), what);
+		return condition;
+	}
+
+	virtual bool run() = 0;
+public:
+	void update() override
+	{
+		if (run())
+		{
+			LE_INFO("{0}: passed", getName());
+			app.close(0);
+		}
+		else
+			app.close(1);
+	}
+};
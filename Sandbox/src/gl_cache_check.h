@@ -0,0 +1,124 @@
+#pragma once
+
+#include <lead_engine.h>
+
+#include "check_layer.h"
+#include "Platform/OpenGL/gl_state_cache.h"
+#include "Platform/OpenGL/fake_gl.h"
+
+/* Drives GLStateCache against the fake GL function table: a frame's worth of state is set
+   repeatedly, then some of it changes. Every call that reaches the table must be one the cache
+   counted as issued, and the repeats must be elided. Then bound objects are deleted and vertex
+   arrays switched, after which the cache must issue the binds it can no longer vouch for. */
+class GLCacheCheckLayer : public CheckLayer
+{
+private:
+	static constexpr int REPEATS = 100;
+	/* State calls made by setFrameState(). */
+	static constexpr uint64_t CALLS_PER_FRAME = 12;
+
+	void setFrameState(le::GLStateCache& cache, GLuint program)
+	{
+		cache.bindFramebuffer(GL_FRAMEBUFFER, 0);
+		cache.viewport(0, 0, 1280, 720);
+		cache.clearColor(0.1f, 0.1f, 0.1f, 1.0f);
+		cache.useProgram(program);
+		cache.bindVertexArray(1);
+		cache.bindBuffer(GL_ARRAY_BUFFER, 2);
+		cache.activeTexture(GL_TEXTURE0);
+		cache.bindTexture(GL_TEXTURE_2D, 3);
+		cache.enable(GL_DEPTH_TEST);
+		cache.depthFunc(GL_LESS);
+		cache.enable(GL_BLEND);
+		cache.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	}
+
+	/* Checks that the calls since the last step issued expected calls, and advances issued. */
+	static bool expectIssued(const le::GLStateCache& cache, uint64_t& issued, uint64_t expected, const char* what)
+	{
+		uint64_t actual = cache.getStats().issued - issued;
+		issued = cache.getStats().issued;
+		if (actual == expected)
+			return true;
+
+		LE_ERROR("GLCacheCheck: {0} issued {1} calls, expected {2}", what, actual, expected);
+		return false;
+	}
+
+	/* Expects the state left by setFrameState(cache, 5). */
+	bool checkInvalidation(le::GLStateCache& cache)
+	{
+		bool passed = true;
+		uint64_t issued = cache.getStats().issued;
+
+		/* GL unbinds a deleted object, so binding its (possibly recycled) name again must be issued. */
+		cache.deleteBuffer(2);
+		cache.bindBuffer(GL_ARRAY_BUFFER, 2);
+		passed &= expectIssued(cache, issued, 2, "Rebinding a deleted buffer");
+
+		cache.deleteTexture(3);
+		cache.bindTexture(GL_TEXTURE_2D, 3);
+		passed &= expectIssued(cache, issued, 2, "Rebinding a deleted texture");
+
+		cache.deleteVertexArray(1);
+		cache.bindVertexArray(1);
+		passed &= expectIssued(cache, issued, 2, "Rebinding a deleted vertex array");
+
+		/* Deleting the bound framebuffer reverts to the default one, which the cache then knows. */
+		cache.bindFramebuffer(GL_FRAMEBUFFER, 6);
+		cache.deleteFramebuffer(6);
+		cache.bindFramebuffer(GL_FRAMEBUFFER, 0);
+		passed &= expectIssued(cache, issued, 2, "Deleting the bound framebuffer");
+
+		/* The element array binding belongs to the vertex array, the array buffer binding does not. */
+		cache.bindVertexArray(7);
+		cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 8);
+		cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 8);
+		passed &= expectIssued(cache, issued, 2, "Binding an element array twice");
+
+		cache.bindVertexArray(9);
+		cache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 8);
+		cache.bindBuffer(GL_ARRAY_BUFFER, 2);
+		passed &= expectIssued(cache, issued, 2, "Switching vertex arrays");
+
+		return passed;
+	}
+
+	bool run() override
+	{
+		if (!expect(le::FakeGL::load(), "could not load the fake GL table"))
+			return false;
+
+		le::GLStateCache cache;
+		for (int i = 0; i < REPEATS; i++)
+			setFrameState(cache, 4);
+
+		/* Switching programs changes exactly one piece of state. */
+		setFrameState(cache, 5);
+
+		const le::GLStateStats& stats = cache.getStats();
+		uint64_t calls = le::FakeGL::getCallCount();
+		uint64_t expectedIssued = CALLS_PER_FRAME + 1;
+
+		bool passed = calls == stats.issued && stats.issued == expectedIssued && stats.issued + stats.elided == CALLS_PER_FRAME * (REPEATS + 1);
+		if (!passed)
+			LE_ERROR("GLCacheCheck: {0} calls reached GL, cache issued {1} (expected {2}) and elided {3}", calls, stats.issued, expectedIssued, stats.elided);
+
+		passed &= checkInvalidation(cache);
+
+		calls = le::FakeGL::getCallCount();
+		if (calls != stats.issued)
+		{
+			LE_ERROR("GLCacheCheck: {0} calls reached GL, but the cache counted {1} as issued", calls, stats.issued);
+			passed = false;
+		}
+
+		if (passed)
+			LE_INFO("GLCacheCheck: {0} calls reached GL, {1} elided", calls, stats.elided);
+		return passed;
+	}
+public:
+	GLCacheCheckLayer(le::App& app) : CheckLayer(app, "GLCacheCheck")
+	{
+	}
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <lead_engine.h>
+
+#include <cmath>
+
+#include "LeadEngine/event_latency.h"
+
+#include "check_layer.h"
+
+/* Feeds EventLatencyTracker events with injected timestamps and checks the histogram
+   percentiles and which events each present resolves. */
+class LatencyCheckLayer : public CheckLayer
+{
+private:
+	static inline bool near(double a, double b) { return std::fabs(a - b) < 1e-9; }
+
+	bool checkPercentiles()
+	{
+		le::LatencyHistogram histogram;
+		if (!expect(histogram.percentileMs(0.5) == 0.0, "empty histogram has a percentile"))
+			return false;
+
+		/* 1000 us lands in the bucket ending at 2^10 us, 8000 us in the one ending at 2^13 us,
+		   which is clamped to the largest sample. */
+		for (int i = 0; i < 90; i++)
+			histogram.record(1000.0);
+		for (int i = 0; i < 10; i++)
+			histogram.record(8000.0);
+
+		bool passed = histogram.getCount() == 100 && near(histogram.getMaxMs(), 8.0)
+			&& near(histogram.percentileMs(0.5), 1.024) && near(histogram.percentileMs(0.9), 1.024)
+			&& near(histogram.percentileMs(0.91), 8.0) && near(histogram.percentileMs(1.0), 8.0);
+		if (!expect(passed, "percentiles fall in the wrong buckets"))
+			return false;
+
+		/* Sub-microsecond samples share the first bucket. */
+		histogram.reset();
+		histogram.record(0.25);
+		histogram.record(0.5);
+		return expect(histogram.getCount() == 2 && near(histogram.percentileMs(1.0), 0.0005), "sub-microsecond samples misbucketed");
+	}
+
+	bool checkPending()
+	{
+		using namespace std::chrono;
+
+		le::EventLatencyTracker tracker;
+		le::EventClock::time_point start = le::EventClock::now();
+
+		le::KeyPressEvent first(1, 0), second(2, 0);
+		le::MouseMoveEvent move(0.0f, 0.0f);
+		first.timestamp = start;
+		second.timestamp = start + milliseconds(1);
+		move.timestamp = start;
+
+		tracker.onEventHandled(first, start + milliseconds(1));
+		tracker.onEventHandled(move, start + milliseconds(2));
+		tracker.onEventHandled(second, start + milliseconds(5));
+
+		/* Only events handled by the present are resolved. */
+		tracker.onPresent(start + milliseconds(4));
+
+		const le::LatencyHistogram* keyHandled = tracker.getHandledLatency(le::EventType::KEY_PRESS);
+		const le::LatencyHistogram* keyPresent = tracker.getPresentLatency(le::EventType::KEY_PRESS);
+		const le::LatencyHistogram* movePresent = tracker.getPresentLatency(le::EventType::MOUSE_MOVE);
+		if (!expect(keyHandled && keyPresent && movePresent, "event types missing"))
+			return false;
+
+		bool passed = first.handledTimestamp == start + milliseconds(1) && keyHandled->getCount() == 2
+			&& near(keyHandled->getMaxMs(), 4.0) && keyPresent->getCount() == 1 && near(keyPresent->getMaxMs(), 4.0)
+			&& movePresent->getCount() == 1 && near(movePresent->getMaxMs(), 4.0);
+		if (!expect(passed, "first present resolved the wrong events"))
+			return false;
+
+		/* The second key press was still pending and resolves now, exactly once. */
+		tracker.onPresent(start + milliseconds(7));
+		tracker.onPresent(start + milliseconds(9));
+		passed = keyPresent->getCount() == 2 && near(keyPresent->getMaxMs(), 6.0) && movePresent->getCount() == 1;
+		if (!expect(passed, "pending event not resolved exactly once"))
+			return false;
+
+		/* Events still pending at a reset belong to the old measurement. */
+		le::KeyPressEvent third(3, 0);
+		third.timestamp = start + milliseconds(10);
+		tracker.onEventHandled(third, start + milliseconds(11));
+		tracker.reset();
+		tracker.onPresent(start + milliseconds(12));
+		if (!expect(keyPresent->getCount() == 0, "event pending at reset resolved after it"))
+			return false;
+
+		return expect(!tracker.getHandledLatency(le::EventType::WINDOW_CLOSE), "unseen event type has a histogram");
+	}
+
+	bool run() override
+	{
+		return checkPercentiles() && checkPending();
+	}
+public:
+	LatencyCheckLayer(le::App& app) : CheckLayer(app, "LatencyCheck")
+	{
+	}
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <lead_engine.h>
+
+#include <chrono>
+
+/* Runs a fixed step particle workload every frame and logs particles updated per millisecond. */
+class ParticleBenchLayer : public le::Layer
+{
+private:
+	le::ParticleSystem particles;
+	double simulatedMs = 0.0;
+	size_t particlesUpdated = 0;
+	int frames = 0;
+public:
+	ParticleBenchLayer(int emitterCount = 64, size_t particlesPerEmitter = 16384) : Layer("ParticleBench")
+	{
+		for (int i = 0; i < emitterCount; i++)
+		{
+			le::ParticleEmitterProps props;
+			props.position[0] = (float)i;
+			props.lifeTime = 2.0f;
+			props.lifeVariation = 0.5f;
+			props.maxParticles = particlesPerEmitter;
+			/* Enough to keep the pool close to full. */
+			props.emissionRate = particlesPerEmitter / props.lifeTime;
+			particles.addEmitter(props);
+		}
+	}
+
+	void update() override
+	{
+		auto start = std::chrono::steady_clock::now();
+		particles.simulate(1.0f / 60.0f);
+		auto end = std::chrono::steady_clock::now();
+
+		simulatedMs += std::chrono::duration<double, std::milli>(end - start).count();
+		particlesUpdated += particles.getAliveCount();
+
+		if (++frames == 120)
+		{
+			LE_INFO("ParticleBench: {0} alive, {1:.0f} particles/ms", particles.getAliveCount(), particlesUpdated / simulatedMs);
+			simulatedMs = 0.0;
+			particlesUpdated = 0;
+			frames = 0;
+		}
+	}
+};
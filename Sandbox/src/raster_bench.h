@@ -0,0 +1,65 @@
+#pragma once
+
+#include <lead_engine.h>
+
+#include <chrono>
+#include <cmath>
+#include <random>
+
+/* Draws a fixed field of small triangles with the software rasterizer every frame and logs
+   throughput. If dumpPath is set, the first frame is written there for inspection. */
+class RasterBenchLayer : public le::Layer
+{
+private:
+	le::SoftFramebuffer framebuffer;
+	le::SoftRasterizer rasterizer;
+	std::vector<le::SoftVertex> vertices;
+	std::vector<uint32_t> indices;
+	double drawMs = 0.0;
+	int frames = 0;
+	std::string dumpPath;
+public:
+	RasterBenchLayer(const std::string& dumpPath = "", size_t triangleCount = 100000, unsigned int width = 1280, unsigned int height = 720)
+		: Layer("RasterBench"), framebuffer(width, height), dumpPath(dumpPath)
+	{
+		std::mt19937 rng(1);
+		std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+		for (size_t i = 0; i < triangleCount; i++)
+		{
+			float cx = dist(rng), cy = dist(rng), z = dist(rng) * 0.9f;
+
+			for (int v = 0; v < 3; v++)
+			{
+				float angle = v * 2.0943951f;
+				vertices.push_back({ cx + 0.03f * std::cos(angle), cy + 0.03f * std::sin(angle), z, 1.0f,
+					dist(rng) * 0.5f + 0.5f, dist(rng) * 0.5f + 0.5f, dist(rng) * 0.5f + 0.5f, 1.0f });
+				indices.push_back((uint32_t)vertices.size() - 1);
+			}
+		}
+	}
+
+	void update() override
+	{
+		auto start = std::chrono::steady_clock::now();
+		framebuffer.clear();
+		rasterizer.draw(framebuffer, vertices.data(), indices.data(), indices.size());
+		auto end = std::chrono::steady_clock::now();
+
+		if (!dumpPath.empty())
+		{
+			if (!framebuffer.writePPM(dumpPath))
+				LE_ERROR("RasterBench: could not write {0}", dumpPath);
+			dumpPath.clear();
+		}
+
+		drawMs += std::chrono::duration<double, std::milli>(end - start).count();
+
+		if (++frames == 120)
+		{
+			LE_INFO("RasterBench: {0:.2f} ms/frame, {1:.0f} triangles/ms", drawMs / frames, indices.size() / 3 * frames / drawMs);
+			drawMs = 0.0;
+			frames = 0;
+		}
+	}
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <lead_engine.h>
+
+#include "check_layer.h"
+
+/* Renders a small fixed scene with the software rasterizer and compares it against a reference
+   PPM. On a mismatch the rendered frame is written next to the reference as
+   <reference>.actual.ppm. The scene covers depth testing, back face culling, shared edges,
+   perspective correct colour and triangles whose screen coordinates overflow an int. */
+class RasterGoldenLayer : public CheckLayer
+{
+private:
+	/* Allows for rounding differences between compilers along edges and in interpolated colour. */
+	static constexpr uint8_t CHANNEL_TOLERANCE = 2;
+	static constexpr size_t MAX_DIFFERENT_PIXELS = 16;
+
+	std::string goldenPath;
+	le::SoftFramebuffer framebuffer;
+	le::SoftRasterizer rasterizer;
+
+	void drawScene()
+	{
+		const le::SoftVertex vertices[] =
+		{
+			/* Red triangle at mid depth. */
+			{ -0.9f, -0.8f, 0.5f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f },
+			{  0.3f, -0.8f, 0.5f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f },
+			{ -0.3f,  0.7f, 0.5f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f },
+			/* Blue triangle behind it, drawn later so only the depth test hides it. */
+			{ -0.5f, -0.6f, 0.8f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f },
+			{  0.7f, -0.6f, 0.8f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f },
+			{  0.1f,  0.9f, 0.8f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f },
+			/* Clockwise, so culled. */
+			{ -1.0f,  1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f },
+			{  1.0f,  1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f },
+			{  1.0f, -1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f },
+			/* Quad of two triangles sharing a diagonal, in front, with varying w and colour. */
+			{  0.2f, -0.2f, 0.1f, 1.0f, 1.0f, 1.0f, 0.0f, 1.0f },
+			{  1.6f, -0.4f, 0.2f, 2.0f, 0.0f, 1.0f, 0.0f, 1.0f },
+			{  1.6f,  1.6f, 0.2f, 2.0f, 0.0f, 1.0f, 1.0f, 1.0f },
+			{  0.2f,  0.8f, 0.1f, 1.0f, 1.0f, 0.0f, 1.0f, 1.0f },
+			/* Tiny w puts this one billions of pixels off the bottom right, past the int range. */
+			{ 1000.0f, -1000.0f, 0.0f, 2e-5f, 1.0f, 1.0f, 1.0f, 1.0f },
+			{ 1001.0f, -1000.0f, 0.0f, 2e-5f, 1.0f, 1.0f, 1.0f, 1.0f },
+			{ 1000.0f,  -999.0f, 0.0f, 2e-5f, 1.0f, 1.0f, 1.0f, 1.0f },
+			/* Just as huge but covering the whole screen, beyond the far plane so it draws nothing. */
+			{ -1000.0f, -1000.0f, 4e-5f, 2e-5f, 1.0f, 1.0f, 1.0f, 1.0f },
+			{  1000.0f, -1000.0f, 4e-5f, 2e-5f, 1.0f, 1.0f, 1.0f, 1.0f },
+			{     0.0f,  1000.0f, 4e-5f, 2e-5f, 1.0f, 1.0f, 1.0f, 1.0f },
+		};
+		const uint32_t indices[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 9, 11, 12, 13, 14, 15, 16, 17, 18 };
+
+		framebuffer.clear(le::SoftFramebuffer::packColor(16, 16, 16, 255));
+		rasterizer.draw(framebuffer, vertices, indices, sizeof(indices) / sizeof(indices[0]));
+	}
+
+	bool run() override
+	{
+		drawScene();
+
+		le::SoftFramebuffer golden(1, 1);
+		size_t different = golden.readPPM(goldenPath) ? framebuffer.countDifferentPixels(golden, CHANNEL_TOLERANCE) : framebuffer.getWidth() * framebuffer.getHeight();
+
+		if (different <= MAX_DIFFERENT_PIXELS)
+		{
+			LE_INFO("RasterGolden: matches {0} ({1} pixels outside tolerance)", goldenPath, different);
+			return true;
+		}
+
+		framebuffer.writePPM(goldenPath + ".actual.ppm");
+		LE_ERROR("RasterGolden: {0} pixels differ from {1}, wrote {1}.actual.ppm", different, goldenPath);
+		return false;
+	}
+public:
+	RasterGoldenLayer(le::App& app, const std::string& goldenPath)
+		: CheckLayer(app, "RasterGolden"), goldenPath(goldenPath), framebuffer(160, 120)
+	{
+	}
+};
@@ -1,5 +1,24 @@
 #include <lead_engine.h>
 
+#include <cstdlib>
+#include <cstring>
+
+#include "particle_bench.h"
+#include "raster_bench.h"
+#include "snapshot_bench.h"
+#include "animation_bench.h"
+#include "text_bench.h"
+#include "raster_golden.h"
+#include "snapshot_check.h"
+#include "text_check.h"
+#include "slot_map_check.h"
+#include "transform_check.h"
+#include "latency_check.h"
+#include "animation_check.h"
+#ifdef LE_FAKE_GL
+#include "gl_cache_check.h"
+#endif
+
 class ExampleLayer : public le::Layer
 {
 public:
@@ -19,12 +38,136 @@ public:
 	}
 };
 
+struct SandboxOptions;
+
+/* A layer the Sandbox runs instead of ExampleLayer, selected by flag on the command line. If
+   argument is set the flag must be followed by it: either that exact word, as in
+   --bench particles, or any value when it is a <placeholder>, passed on as options.argument.
+   Headless modes open no window and need no GPU. */
+struct SandboxMode
+{
+	const char* flag;
+	const char* argument;
+	bool headless;
+	std::unique_ptr<le::Layer> (*create)(le::App& app, const SandboxOptions& options);
+};
+
+/* Command line: Sandbox [mode] [--headless] [--frames <count>] [--dump <file.ppm>], with the
+   modes listed in MODES below. Benchmarks share the frame and the thread pool, so only one mode
+   runs. Checks close the app with exit code 0 on success. --dump writes the raster benchmark's
+   last frame. */
+struct SandboxOptions
+{
+	const SandboxMode* mode = nullptr;
+	std::string argument;
+	std::string dumpPath;
+	bool headless = false;
+	unsigned int frames = 0;
+
+	SandboxOptions(int argc, char** argv);
+
+	le::WindowData getWindowData() const
+	{
+		return le::WindowData("Lead Engine", 1280, 720, headless || (mode && mode->headless), frames);
+	}
+private:
+	/* Selects the mode matching argv[i], consuming its argument. Returns false if none matches. */
+	bool selectMode(int argc, char** argv, int& i);
+};
+
+template<typename T>
+static std::unique_ptr<le::Layer> createCheck(le::App& app, const SandboxOptions&)
+{
+	return std::make_unique<T>(app);
+}
+
+template<typename T>
+static std::unique_ptr<le::Layer> createBench(le::App&, const SandboxOptions&)
+{
+	return std::make_unique<T>();
+}
+
+static const SandboxMode MODES[] =
+{
+	{ "--bench", "particles", false, createBench<ParticleBenchLayer> },
+	{ "--bench", "raster", false, [](le::App&, const SandboxOptions& options) -> std::unique_ptr<le::Layer> { return std::make_unique<RasterBenchLayer>(options.dumpPath); } },
+	{ "--bench", "snapshot", false, createBench<SnapshotBenchLayer> },
+	{ "--bench", "animation", false, createBench<AnimationBenchLayer> },
+	{ "--bench", "text", false, createBench<TextBenchLayer> },
+	{ "--golden", "<reference.ppm>", true, [](le::App& app, const SandboxOptions& options) -> std::unique_ptr<le::Layer> { return std::make_unique<RasterGoldenLayer>(app, options.argument); } },
+	/* Needs the fake GL table, which only Debug builds include. */
+#ifdef LE_FAKE_GL
+	{ "--gl-cache-check", nullptr, true, createCheck<GLCacheCheckLayer> },
+#endif
+	{ "--snapshot-check", nullptr, true, createCheck<SnapshotCheckLayer> },
+	{ "--text-check", nullptr, true, createCheck<TextCheckLayer> },
+	{ "--slot-map-check", nullptr, true, createCheck<SlotMapCheckLayer> },
+	{ "--transform-check", nullptr, true, createCheck<TransformCheckLayer> },
+	{ "--latency-check", nullptr, true, createCheck<LatencyCheckLayer> },
+	{ "--animation-check", nullptr, true, createCheck<AnimationCheckLayer> },
+};
+
+SandboxOptions::SandboxOptions(int argc, char** argv)
+{
+	bool unknown = false;
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "--dump") == 0 && i + 1 < argc)
+			dumpPath = argv[++i];
+		else if (std::strcmp(argv[i], "--headless") == 0)
+			headless = true;
+		else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+			frames = (unsigned int)std::strtoul(argv[++i], nullptr, 10);
+		else if (!selectMode(argc, argv, i))
+		{
+			LE_WARN("Ignoring unknown argument {0}", argv[i]);
+			unknown = true;
+		}
+	}
+
+	if (unknown)
+	{
+		std::string usage = "Usage: Sandbox";
+		for (const SandboxMode& candidate : MODES)
+			usage += std::string(" [") + candidate.flag + (candidate.argument ? std::string(" ") + candidate.argument : "") + "]";
+		LE_INFO("{0} [--headless] [--frames <count>] [--dump <file.ppm>]", usage);
+	}
+}
+
+bool SandboxOptions::selectMode(int argc, char** argv, int& i)
+{
+	for (const SandboxMode& candidate : MODES)
+	{
+		if (std::strcmp(argv[i], candidate.flag) != 0)
+			continue;
+		if (candidate.argument && (i + 1 >= argc || (candidate.argument[0] != '<' && std::strcmp(argv[i + 1], candidate.argument) != 0)))
+			continue;
+
+		if (mode)
+			LE_WARN("Only one mode runs at a time, ignoring {0}", argv[i]);
+		else
+			mode = &candidate;
+
+		if (candidate.argument)
+		{
+			if (mode == &candidate)
+				argument = argv[i + 1];
+			i++;
+		}
+		return true;
+	}
+	return false;
+}
+
 class Sandbox : public le::App
 {
 public:
-	Sandbox()
+	Sandbox(const SandboxOptions& options) : App(options.getWindowData())
 	{
-		pushLayer(new ExampleLayer());
+		if (options.mode)
+			pushLayer(options.mode->create(*this, options));
+		else
+			pushLayer(std::make_unique<ExampleLayer>());
 	}
 	~Sandbox()
 	{
@@ -32,7 +175,7 @@ public:
 	}
 };
 
-le::App* le::create_app()
+le::App* le::create_app(int argc, char** argv)
 {
-	return new Sandbox();
-}
\ No newline at end of file
+	return new Sandbox(SandboxOptions(argc, argv));
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <lead_engine.h>
+
+#include "LeadEngine/slot_map.h"
+
+#include "check_layer.h"
+
+/* Exercises SlotMap insert, erase and slot reuse, and checks that stale, null and forged
+   handles are rejected. */
+class SlotMapCheckLayer : public CheckLayer
+{
+private:
+	bool run() override
+	{
+		le::SlotMap<int> map;
+
+		le::Handle<int> a = map.insert(1);
+		le::Handle<int> b = map.insert(2);
+		le::Handle<int> c = map.insert(3);
+		if (!expect(map.size() == 3 && *map.get(a) == 1 && *map.get(b) == 2 && *map.get(c) == 3, "inserted values not found"))
+			return false;
+
+		/* Erasing from the middle moves the last value, other handles must still resolve. */
+		if (!expect(map.erase(a) && !map.contains(a) && !map.get(a) && !map.erase(a), "erased handle still resolves"))
+			return false;
+		if (!expect(map.size() == 2 && *map.get(b) == 2 && *map.get(c) == 3, "erase broke other handles"))
+			return false;
+
+		/* A freed slot: its generation bumped once. A forged handle with that generation must
+		   not reach the free list link stored in the slot. */
+		le::Handle<int> forged = { a.index, a.generation + 1 };
+		if (!expect(!map.contains(forged) && !map.get(forged), "forged handle to a free slot resolves"))
+			return false;
+
+		/* The freed slot is reused with a new generation, the old handle stays stale. */
+		le::Handle<int> d = map.insert(4);
+		if (!expect(d.index == a.index && d != a && *map.get(d) == 4 && !map.get(a), "reused slot accepts the stale handle"))
+			return false;
+
+		if (!expect(!map.contains(le::Handle<int>()) && !map.contains({ 1000, 1 }), "null or out of range handle resolves"))
+			return false;
+
+		int sum = 0;
+		for (int value : map)
+			sum += value;
+		if (!expect(sum == 9, "dense iteration missed values"))
+			return false;
+
+		map.clear();
+		return expect(map.empty() && !map.get(b) && !map.get(c) && !map.get(d), "clear left values behind");
+	}
+public:
+	SlotMapCheckLayer(le::App& app) : CheckLayer(app, "SlotMapCheck")
+	{
+	}
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <lead_engine.h>
+
+#include <chrono>
+
+/* Replicates a block of moving entities over a loopback transport every frame and logs the
+   bandwidth and the cost of capturing and restoring snapshots. */
+class SnapshotBenchLayer : public le::Layer
+{
+private:
+	struct Entity
+	{
+		float position[3];
+		float velocity[3];
+		uint32_t flags;
+	};
+
+	static constexpr size_t ENTITY_COUNT = 4096;
+
+	/* Separate copies of the state so both ends can live in one process. */
+	Entity authorityEntities[ENTITY_COUNT] = {};
+	Entity clientEntities[ENTITY_COUNT] = {};
+
+	le::StateRegistry authorityState, clientState;
+	le::SnapshotSender sender;
+	le::SnapshotReceiver receiver;
+	le::LoopbackTransport transport;
+
+	uint32_t tick = 0;
+	double captureMs = 0.0, restoreMs = 0.0;
+	size_t bytes = 0;
+	int frames = 0;
+public:
+	SnapshotBenchLayer() : Layer("SnapshotBench"), sender(authorityState), receiver(clientState)
+	{
+		authorityState.registerState("entities", authorityEntities);
+		clientState.registerState("entities", clientEntities);
+
+		for (size_t i = 0; i < ENTITY_COUNT; i++)
+			authorityEntities[i].velocity[0] = (float)(i % 7) * 0.1f;
+
+		transport.setDropRate(0.05f);
+	}
+
+	void update() override
+	{
+		/* Only a quarter of the entities move each tick, the rest should cost almost nothing. */
+		for (size_t i = tick % 4; i < ENTITY_COUNT; i += 4)
+			for (int axis = 0; axis < 3; axis++)
+				authorityEntities[i].position[axis] += authorityEntities[i].velocity[axis] * (1.0f / 60.0f);
+
+		std::vector<uint8_t> packet, ack;
+
+		auto start = std::chrono::steady_clock::now();
+		sender.writeTick(tick++, packet);
+		auto captured = std::chrono::steady_clock::now();
+
+		transport.send(le::LoopbackTransport::AUTHORITY, packet);
+		bytes += packet.size();
+
+		/* One ack packet per snapshot, the sender only reads the first tick of each. */
+		while (transport.receive(le::LoopbackTransport::CLIENT, packet))
+		{
+			ack.clear();
+			if (receiver.readTick(packet, ack))
+				transport.send(le::LoopbackTransport::CLIENT, ack);
+		}
+		auto restored = std::chrono::steady_clock::now();
+
+		while (transport.receive(le::LoopbackTransport::AUTHORITY, ack))
+			sender.readAck(ack);
+
+		captureMs += std::chrono::duration<double, std::milli>(captured - start).count();
+		restoreMs += std::chrono::duration<double, std::milli>(restored - captured).count();
+
+		if (++frames == 120)
+		{
+			LE_INFO("SnapshotBench: {0} bytes/tick ({1} bytes raw), capture {2:.3f} ms, restore {3:.3f} ms",
+				bytes / frames, sizeof(authorityEntities), captureMs / frames, restoreMs / frames);
+			captureMs = restoreMs = 0.0;
+			bytes = 0;
+			frames = 0;
+		}
+	}
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <lead_engine.h>
+
+#include <cstring>
+
+#include "check_layer.h"
+
+/* Replicates a block of entities over a lossy loopback transport and compares the client's
+   copy with the authority's after every snapshot that gets through. Acks travel back over the
+   same lossy transport and are only read every few ticks, so deltas are encoded against
+   baselines several ticks old and lost acks force re-baselining. Passes if every received
+   snapshot matched. */
+class SnapshotCheckLayer : public CheckLayer
+{
+private:
+	struct Entity
+	{
+		float position[3];
+		uint32_t flags;
+	};
+
+	static constexpr size_t ENTITY_COUNT = 1024;
+	static constexpr uint32_t TICKS = 600;
+	static constexpr uint32_t ACK_INTERVAL = 3;
+	static constexpr float DROP_RATE = 0.2f;
+
+	Entity authorityEntities[ENTITY_COUNT] = {};
+	Entity clientEntities[ENTITY_COUNT] = {};
+
+	le::StateRegistry authorityState, clientState;
+	le::SnapshotSender sender;
+	le::SnapshotReceiver receiver;
+	le::LoopbackTransport transport;
+
+	uint32_t tick = 0;
+	uint32_t received = 0, mismatches = 0;
+
+	void simulate()
+	{
+		/* A changing subset moves each tick and a few flags toggle, the rest stays put. */
+		for (size_t i = tick % 5; i < ENTITY_COUNT; i += 5)
+			for (int axis = 0; axis < 3; axis++)
+				authorityEntities[i].position[axis] += (float)((i + axis) % 9) * 0.01f;
+
+		authorityEntities[(tick * 37) % ENTITY_COUNT].flags ^= 1u << (tick % 32);
+	}
+
+	void runTick()
+	{
+		simulate();
+
+		std::vector<uint8_t> packet;
+		sender.writeTick(tick, packet);
+		transport.send(le::LoopbackTransport::AUTHORITY, packet);
+
+		while (transport.receive(le::LoopbackTransport::CLIENT, packet))
+		{
+			std::vector<uint8_t> ack;
+			if (!receiver.readTick(packet, ack))
+				continue;
+
+			transport.send(le::LoopbackTransport::CLIENT, ack);
+			received++;
+
+			/* Nothing is delayed, so a snapshot that got through is this tick's. */
+			if (receiver.getLatestTick() != tick || std::memcmp(clientEntities, authorityEntities, sizeof(authorityEntities)) != 0)
+			{
+				if (mismatches++ == 0)
+					LE_ERROR("SnapshotCheck: client state differs from the authority at tick {0}", tick);
+			}
+		}
+
+		if (tick % ACK_INTERVAL == 0)
+			while (transport.receive(le::LoopbackTransport::AUTHORITY, packet))
+				sender.readAck(packet);
+	}
+
+	bool run() override
+	{
+		for (tick = 0; tick < TICKS; tick++)
+			runTick();
+
+		/* Some snapshots must be dropped for the check to mean anything, and most must arrive. */
+		bool passed = mismatches == 0 && received < TICKS && received > TICKS / 2;
+		if (passed)
+			LE_INFO("SnapshotCheck: {0} of {1} snapshots received, all matched the authority", received, TICKS);
+		else
+			LE_ERROR("SnapshotCheck: {0} of {1} snapshots received, {2} mismatched", received, TICKS, mismatches);
+		return passed;
+	}
+public:
+	SnapshotCheckLayer(le::App& app) : CheckLayer(app, "SnapshotCheck"), sender(authorityState), receiver(clientState)
+	{
+		authorityState.registerState("entities", authorityEntities);
+		clientState.registerState("entities", clientEntities);
+
+		transport.setDropRate(DROP_RATE, 7);
+	}
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <lead_engine.h>
+
+#include <chrono>
+
+/* Lays out a screen full of labels with the debug font each frame and logs how long it takes,
+   how many draw calls the quads need and how often the run and glyph caches hit. Runs without a GPU. */
+class TextBenchLayer : public le::Layer
+{
+private:
+	le::DebugFont font;
+	le::GlyphCache glyphs;
+	le::TextRenderer text;
+	std::vector<std::string> labels;
+	double updateMs = 0.0;
+	int frames = 0;
+public:
+	/* Every label is redrawn each frame in the same order, so the run cache must hold them all:
+	   an LRU cycled through more keys than it holds never hits. */
+	TextBenchLayer(size_t labelCount = 5000)
+		: Layer("TextBench"), glyphs(font, 512, 512), text(glyphs, labelCount)
+	{
+		for (size_t i = 0; i < labelCount; i++)
+			labels.push_back("Unit " + std::to_string(i % 2000) + " HP " + std::to_string(i % 97));
+	}
+
+	void update() override
+	{
+		auto start = std::chrono::steady_clock::now();
+		text.begin();
+		for (size_t i = 0; i < labels.size(); i++)
+			text.drawText(labels[i], (float)(i % 20) * 96.0f, (float)(i / 20) * 12.0f, (uint16_t)(8 + (i % 3) * 8));
+		auto end = std::chrono::steady_clock::now();
+
+		updateMs += std::chrono::duration<double, std::milli>(end - start).count();
+
+		if (++frames == 120)
+		{
+			LE_INFO("TextBench: {0} labels, {1} quads in {2} batches, {3:.3f} ms, run hit rate {4:.3f}, glyph hit rate {5:.3f}, {6} glyphs in {7} shelves",
+				labels.size(), text.getQuads().size(), text.getBatchCount(), updateMs / frames,
+				text.getStats().getRunHitRate(), glyphs.getStats().getHitRate(), glyphs.getGlyphCount(), glyphs.getAtlas().getShelfCount());
+			text.resetStats();
+			glyphs.resetStats();
+			updateMs = 0.0;
+			frames = 0;
+		}
+	}
+};
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <lead_engine.h>
+
+#include "check_layer.h"
+
+/* Drives GlyphCache with the debug font. First a working set far larger than a small atlas,
+   so shelves are evicted and reused every frame. After each frame no two glyph rects may
+   overlap, every glyph's texels must match its bitmap and the gutter right of and below
+   each glyph must be empty. Then a working set that fits must hit the cache once warm,
+   blank glyphs must take no atlas space and a glyph larger than the atlas must be drawn
+   blank instead of retried forever. */
+class TextCheckLayer : public CheckLayer
+{
+private:
+	static constexpr int CHURN_FRAMES = 40;
+	static constexpr int WARM_FRAMES = 20;
+	static constexpr float MIN_WARM_HIT_RATE = 0.99f;
+
+	le::DebugFont font;
+
+	/* Requests glyphs for one frame and lets them arrive, as a frame plus a worker round trip would. */
+	void runFrame(le::GlyphCache& cache, const char* text, std::initializer_list<uint16_t> pixelSizes)
+	{
+		cache.update();
+		for (uint16_t pixelSize : pixelSizes)
+			for (const char* c = text; *c; c++)
+				cache.get((uint32_t)*c, pixelSize);
+		cache.waitForPending();
+	}
+
+	bool checkAtlas(le::GlyphCache& cache)
+	{
+		le::GlyphAtlas& atlas = cache.getAtlas();
+		const uint8_t* pixels = atlas.getPixels();
+		uint16_t atlasWidth = atlas.getWidth();
+		uint16_t atlasHeight = atlas.getHeight();
+
+		std::vector<const le::GlyphInfo*> placed;
+		std::vector<uint64_t> keys;
+		for (const auto& [key, info] : cache.getGlyphs())
+		{
+			if (!info.ready || info.rect.width == 0)
+				continue;
+			placed.push_back(&info);
+			keys.push_back(key);
+		}
+
+		for (size_t i = 0; i < placed.size(); i++)
+		{
+			const le::AtlasRect& a = placed[i]->rect;
+			if (a.x + a.width >= atlasWidth || a.y + a.height >= atlasHeight)
+			{
+				LE_ERROR("TextCheck: glyph at ({0}, {1}) leaves no gutter inside the atlas", a.x, a.y);
+				return false;
+			}
+
+			for (size_t j = i + 1; j < placed.size(); j++)
+			{
+				const le::AtlasRect& b = placed[j]->rect;
+				if (a.x <= b.x + b.width && b.x <= a.x + a.width && a.y <= b.y + b.height && b.y <= a.y + a.height)
+				{
+					LE_ERROR("TextCheck: glyphs at ({0}, {1}) and ({2}, {3}) overlap, padding included", a.x, a.y, b.x, b.y);
+					return false;
+				}
+			}
+
+			le::GlyphBitmap bitmap;
+			font.rasterize((uint32_t)keys[i], (uint16_t)(keys[i] >> 32), bitmap);
+			for (uint16_t y = 0; y <= a.height; y++)
+				for (uint16_t x = 0; x <= a.width; x++)
+				{
+					bool gutter = x == a.width || y == a.height;
+					uint8_t expected = gutter ? 0 : bitmap.coverage[(size_t)y * a.width + x];
+					if (pixels[(size_t)(a.y + y) * atlasWidth + a.x + x] != expected)
+					{
+						LE_ERROR("TextCheck: stale texel at ({0}, {1}) in the glyph at ({2}, {3})", a.x + x, a.y + y, a.x, a.y);
+						return false;
+					}
+				}
+		}
+
+		return true;
+	}
+
+	bool checkEviction()
+	{
+		le::GlyphCache cache(font, 96, 96);
+		const char* text = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+
+		for (int frame = 0; frame < CHURN_FRAMES; frame++)
+		{
+			/* Sizes shrink frame by frame, so evicted shelves are reused by shorter, narrower glyphs. */
+			runFrame(cache, text, { (uint16_t)(40 - (frame % 5) * 8) });
+			if (!checkAtlas(cache))
+				return false;
+		}
+
+		if (!expect(cache.getStats().evictions > 0, "the working set fit in the atlas, nothing was evicted"))
+			return false;
+
+		LE_INFO("TextCheck: {0} evictions, atlas consistent after every frame", cache.getStats().evictions);
+		return true;
+	}
+
+	bool checkWarmHitRate()
+	{
+		le::GlyphCache cache(font, 256, 256);
+		const char* text = "Unit 1234 HP 56789";
+
+		/* The first frame misses, the second packs what arrived. */
+		runFrame(cache, text, { 16 });
+		runFrame(cache, text, { 16 });
+		cache.resetStats();
+
+		for (int frame = 0; frame < WARM_FRAMES; frame++)
+			runFrame(cache, text, { 16 });
+
+		float hitRate = cache.getStats().getHitRate();
+		if (hitRate < MIN_WARM_HIT_RATE)
+		{
+			LE_ERROR("TextCheck: warm hit rate {0:.3f}, expected at least {1:.2f}", hitRate, MIN_WARM_HIT_RATE);
+			return false;
+		}
+
+		const le::GlyphInfo* space = cache.get(' ', 16);
+		if (!expect(space && space->rect.width == 0 && space->metrics.advance > 0.0f, "the space glyph should have metrics and no atlas rect"))
+			return false;
+
+		LE_INFO("TextCheck: warm hit rate {0:.3f}", hitRate);
+		return true;
+	}
+	bool checkOversized()
+	{
+		le::GlyphCache cache(font, 32, 32);
+		runFrame(cache, "A", { 64 });
+		runFrame(cache, "A", { 64 });
+
+		const le::GlyphInfo* glyph = cache.get('A', 64);
+		return expect(glyph && glyph->rect.width == 0 && glyph->shelf == le::GlyphAtlas::NO_SHELF, "a glyph larger than the atlas should be ready with no atlas rect");
+	}
+
+	bool run() override
+	{
+		return checkEviction() && checkWarmHitRate() && checkOversized();
+	}
+public:
+	TextCheckLayer(le::App& app) : CheckLayer(app, "TextCheck")
+	{
+	}
+};
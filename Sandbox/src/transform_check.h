@@ -0,0 +1,147 @@
+#pragma once
+
+#include <lead_engine.h>
+
+#include <chrono>
+#include <cstring>
+
+#include "check_layer.h"
+
+/* Builds a 4-ary TransformHierarchy of 131072 nodes and checks every world matrix against a
+   straightforward recomputation after a full update and after sparse edits. A clean frame
+   must update nothing and a sparse frame exactly the edited subtrees. Destroyed nodes' handles
+   must stay stale once their indices are reused. Logs the cost of each kind of frame. */
+class TransformCheckLayer : public CheckLayer
+{
+private:
+	using NodeId = le::TransformHierarchy::NodeId;
+
+	static constexpr size_t NODE_COUNT = 131072;
+	static constexpr size_t BRANCHING = 4;
+
+	le::TransformHierarchy hierarchy;
+	std::vector<NodeId> nodes;
+	std::vector<le::LocalTransform> locals;
+
+	static inline size_t parentOf(size_t i) { return (i - 1) / BRANCHING; }
+
+	static le::LocalTransform makeLocal(size_t i, float angle)
+	{
+		le::LocalTransform local;
+		local.position[0] = (float)(i % 7) * 0.25f;
+		local.position[1] = (float)(i % 3) * 0.5f;
+		local.rotation[2] = std::sin(angle * 0.5f);
+		local.rotation[3] = std::cos(angle * 0.5f);
+		return local;
+	}
+
+	/* Same operations in the same order as the hierarchy, so the results must match exactly. */
+	bool worldsMatch()
+	{
+		std::vector<le::Mat4> reference(NODE_COUNT);
+		for (size_t i = 0; i < NODE_COUNT; i++)
+		{
+			le::Mat4 local = le::Mat4::fromTRS(locals[i].position, locals[i].rotation, locals[i].scale);
+			reference[i] = i == 0 ? local : reference[parentOf(i)] * local;
+
+			if (std::memcmp(&reference[i], &hierarchy.getWorld(nodes[i]), sizeof(le::Mat4)) != 0)
+			{
+				LE_ERROR("TransformCheck: world matrix of node {0} is wrong", i);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/* Nodes that are in or below one of the edited nodes. */
+	size_t countCovered(const std::vector<size_t>& edited)
+	{
+		std::vector<uint8_t> covered(NODE_COUNT, 0);
+		for (size_t i : edited)
+			covered[i] = 1;
+
+		size_t count = 0;
+		for (size_t i = 0; i < NODE_COUNT; i++)
+		{
+			if (i > 0)
+				covered[i] |= covered[parentOf(i)];
+			count += covered[i];
+		}
+		return count;
+	}
+
+	double timedUpdate()
+	{
+		auto start = std::chrono::steady_clock::now();
+		hierarchy.update();
+		auto end = std::chrono::steady_clock::now();
+		return std::chrono::duration<double, std::milli>(end - start).count();
+	}
+
+	bool run() override
+	{
+		for (size_t i = 0; i < NODE_COUNT; i++)
+		{
+			locals.push_back(makeLocal(i, (float)i * 0.001f));
+			nodes.push_back(hierarchy.createNode(i == 0 ? le::TransformHierarchy::INVALID_NODE : nodes[parentOf(i)], locals[i]));
+		}
+
+		double fullMs = timedUpdate();
+		if (!expect(hierarchy.getLastUpdatedCount() == NODE_COUNT, "first update did not compute every node") || !worldsMatch())
+			return false;
+
+		double cleanMs = timedUpdate();
+		if (!expect(hierarchy.getLastUpdatedCount() == 0, "clean frame updated nodes"))
+			return false;
+
+		/* A few leaves, one mid-level subtree and a node inside that subtree. */
+		std::vector<size_t> edited = { NODE_COUNT - 1, NODE_COUNT - 500, NODE_COUNT / 2, 5, 5 * BRANCHING + 1 };
+		for (size_t i : edited)
+		{
+			locals[i] = makeLocal(i, 1.0f);
+			hierarchy.setLocal(nodes[i], locals[i]);
+		}
+
+		double sparseMs = timedUpdate();
+		if (!expect(hierarchy.getLastUpdatedCount() == countCovered(edited), "sparse frame did not update exactly the edited subtrees") || !worldsMatch())
+			return false;
+
+		/* Moving the root is a full pass. */
+		locals[0] = makeLocal(0, 0.5f);
+		hierarchy.setLocal(nodes[0], locals[0]);
+		double rootMs = timedUpdate();
+		if (!expect(hierarchy.getLastUpdatedCount() == NODE_COUNT, "moving the root did not update every node") || !worldsMatch())
+			return false;
+
+		/* Destroy a leaf, then reuse its index. */
+		NodeId leaf = nodes.back();
+		hierarchy.destroyNode(leaf);
+		hierarchy.update();
+		NodeId reused = hierarchy.createNode(nodes[parentOf(NODE_COUNT - 1)], locals.back());
+		hierarchy.update();
+
+		bool stale = reused.index == leaf.index && !hierarchy.isValid(leaf) && hierarchy.isValid(reused)
+			&& !hierarchy.setLocal(leaf, le::LocalTransform()) && !hierarchy.destroyNode(leaf)
+			&& hierarchy.createNode(leaf) == le::TransformHierarchy::INVALID_NODE;
+		if (!expect(stale, "a destroyed node's handle aliases the node that reused its index"))
+			return false;
+
+		nodes.back() = reused;
+		if (!worldsMatch())
+			return false;
+
+		/* Destroying a subtree invalidates every handle in it. */
+		hierarchy.destroyNode(nodes[1]);
+		hierarchy.update();
+		if (!expect(!hierarchy.isValid(nodes[1]) && !hierarchy.isValid(nodes[1 * BRANCHING + 1]) && hierarchy.isValid(nodes[2]), "destroyed subtree still valid"))
+			return false;
+
+		LE_INFO("TransformCheck: {0} nodes, full {1:.3f} ms, clean {2:.4f} ms, sparse ({3} nodes) {4:.4f} ms, root {5:.3f} ms",
+			NODE_COUNT, fullMs, cleanMs, countCovered(edited), sparseMs, rootMs);
+		return true;
+	}
+public:
+	TransformCheckLayer(le::App& app) : CheckLayer(app, "TransformCheck")
+	{
+	}
+};
@@ -0,0 +1,4 @@
+#!/bin/sh
+# Headless Linux build, then: make config=release
+# Golden image check: bin/Release-linux-x86_64/Sandbox/Sandbox --golden Sandbox/assets/golden/raster_scene.ppm
+premake5 gmake2
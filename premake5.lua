@@ -21,7 +21,10 @@ IncludeDir = {}
 IncludeDir["GLFW"] = "LeadEngine/vendor/GLFW/include"
 IncludeDir["Glad"] = "LeadEngine/vendor/Glad/include"
 
-include "LeadEngine/vendor/GLFW"
+-- Linux builds are headless only, so GLFW is not needed there.
+if os.istarget("windows") then
+	include "LeadEngine/vendor/GLFW"
+end
 include "LeadEngine/vendor/Glad"
 
 project "LeadEngine"
@@ -53,18 +56,23 @@ project "LeadEngine"
 
 	links 
 	{ 
-		"GLFW",
-		"Glad",
-		"opengl32.lib"
+		"Glad"
 	}
 
 	filter "system:windows"
 		systemversion "latest"
 
+		links
+		{
+			"GLFW",
+			"opengl32.lib"
+		}
+
 		defines
 		{
 			"LE_PLATFORM_WINDOWS",
 			"LE_BUILD_DLL",
+			"NOMINMAX",
 			"GLFW_INCLUDE_NONE"
 		}
 
@@ -73,21 +81,48 @@ project "LeadEngine"
 			("{COPY} %{cfg.buildtarget.relpath} ../bin/" .. outputdir .. "/Sandbox")
 		}
 
+	filter "system:linux"
+		pic "on"
+		visibility "Hidden"
+
+		removefiles
+		{
+			"%{prj.name}/src/Platform/Windows/**"
+		}
+
+		links
+		{
+			"pthread",
+			"dl"
+		}
+
+		defines
+		{
+			"LE_PLATFORM_LINUX",
+			"LE_BUILD_DLL"
+		}
+
 	filter "configurations:Debug"
-		defines "LE_DEBUG"
-		buildoptions "/MDd"
+		defines { "LE_DEBUG", "LE_FAKE_GL" }
 		symbols "on"
 
+	filter { "system:windows", "configurations:Debug" }
+		buildoptions "/MDd"
+
 	filter "configurations:Release"
 		defines "LE_RELEASE"
-		buildoptions "/MD"
 		optimize "on"
 
+	filter { "system:windows", "configurations:Release" }
+		buildoptions "/MD"
+
 	filter "configurations:Dist"
 		defines "LE_DIST"
-		buildoptions "/MD"
 		optimize "on"
 
+	filter { "system:windows", "configurations:Dist" }
+		buildoptions "/MD"
+
 project "Sandbox"
 	location "Sandbox"
 	kind "ConsoleApp"
@@ -109,6 +144,7 @@ project "Sandbox"
 		"LeadEngine/vendor/spdlog/include",
 		"LeadEngine/src",
 		"LeadEngine/vendor",
+		"%{IncludeDir.Glad}",
 		--"%{IncludeDir.glm}"
 	}
 
@@ -122,20 +158,38 @@ project "Sandbox"
 
 		defines
 		{
-			"LE_PLATFORM_WINDOWS"
+			"LE_PLATFORM_WINDOWS",
+			"NOMINMAX"
+		}
+
+	filter "system:linux"
+		links
+		{
+			"pthread"
+		}
+
+		defines
+		{
+			"LE_PLATFORM_LINUX"
 		}
 		
 	filter "configurations:Debug"
-		defines "LE_DEBUG"
-		buildoptions "/MDd"
+		defines { "LE_DEBUG", "LE_FAKE_GL" }
 		symbols "on"
 
+	filter { "system:windows", "configurations:Debug" }
+		buildoptions "/MDd"
+
 	filter "configurations:Release"
 		defines "LE_RELEASE"
-		buildoptions "/MD"
 		optimize "on"
 
+	filter { "system:windows", "configurations:Release" }
+		buildoptions "/MD"
+
 	filter "configurations:Dist"
 		defines "LE_DIST"
-		buildoptions "/MD"
 		optimize "on"
+
+	filter { "system:windows", "configurations:Dist" }
+		buildoptions "/MD"